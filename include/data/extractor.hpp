@@ -36,10 +36,16 @@ class DataExtractor {
     bool current() const;
     void extract(Observer* observer) const;
 
-  private:
+  protected:
+    // Fetches {base}/{name}/{name}-{version}.zip into the downloads directory, unless it's
+    // already there with `digest`.  It is written to a .part file first; a later call resumes
+    // from that if this one is interrupted, and it is deleted if the whole doesn't match
+    // `digest`.  Protected, so that tests can point it at a local server.
     void download(
             Observer* observer, pn::string_view base, pn::string_view name,
             pn::string_view version, const sfz::sha1::digest& digest) const;
+
+  private:
     void extract_original(Observer* observer, pn::string_view zip) const;
 
     const pn::string _downloads_dir;
@@ -19,10 +19,13 @@
 #ifndef ANTARES_DATA_FIELD_HPP_
 #define ANTARES_DATA_FIELD_HPP_
 
+#include <algorithm>
 #include <pn/fwd>
 #include <pn/string>
 #include <pn/value>
 #include <sfz/sfz.hpp>
+#include <utility>
+#include <vector>
 
 #include "data/enums.hpp"
 #include "data/handle.hpp"
@@ -51,6 +54,10 @@ class path_value {
     path_value get(pn::string_view key) const {
         return path_value{this, Kind::KEY, key, 0, _value.as_map().get(key)};
     }
+    // As get(key), for a caller that has already found the value at `key`.
+    path_value get(pn::string_view key, pn::value_cref value) const {
+        return path_value{this, Kind::KEY, key, 0, value};
+    }
     path_value get(int64_t index) const {
         return path_value{
                 this, Kind::INDEX, pn::string_view{}, index, array_get(_value.as_array(), index)};
@@ -77,6 +84,23 @@ class path_value {
 
 pn::string_view type_string(pn::value_cref x);
 
+// The null value, which is what a map holds for any key it doesn't have.
+pn::value_cref null_value();
+
+// Scratch space for required_struct(), kept from one call to the next, so that reading a struct
+// doesn't allocate once the space has grown to fit the largest map seen.  A nested struct is read
+// while the outer one still holds its scratch space, so each level of nesting gets its own.
+class struct_scratch {
+  public:
+    struct_scratch();
+    struct_scratch(const struct_scratch&) = delete;
+    struct_scratch& operator=(const struct_scratch&) = delete;
+    ~struct_scratch();
+
+    std::vector<pn::value_cref>*                      values;
+    std::vector<std::pair<pn::string_view, size_t>>* keys;
+};
+
 template <typename T>
 struct field_reader;
 
@@ -218,18 +242,49 @@ struct field {
 template <typename T>
 T required_struct(path_value x, const std::map<pn::string_view, field<T>>& fields) {
     if (x.value().is_map()) {
-        T t;
+        // Match keys to fields by walking both in sorted order, instead of searching the map once
+        // per field; most fields are usually absent, and each miss would scan the whole map.  Keys
+        // are sorted together with their position, so that a repeated key resolves to its first
+        // value, and the first unknown key (by position) is the one reported.
+        struct_scratch scratch;
+        auto&          values = *scratch.values;
+        auto&          keys   = *scratch.keys;
+        for (auto kv : x.value().as_map()) {
+            keys.emplace_back(kv.key(), values.size());
+            values.push_back(kv.value());
+        }
+        std::sort(keys.begin(), keys.end());
+
+        T               t;
+        size_t          unknown_index = values.size();
+        pn::string_view unknown_key;
+        auto            k = keys.begin();
         for (const auto& kv : fields) {
-            path_value v = x.get(kv.first);
-            kv.second.set(&t, v);
+            for (; (k != keys.end()) && (k->first < kv.first); ++k) {
+                if (k->second < unknown_index) {
+                    unknown_index = k->second;
+                    unknown_key   = k->first;
+                }
+            }
+            if ((k == keys.end()) || (kv.first < k->first)) {
+                kv.second.set(&t, x.get(kv.first, null_value()));
+                continue;
+            }
+            kv.second.set(&t, x.get(kv.first, values[k->second]));
+            while ((k != keys.end()) && !(kv.first < k->first)) {
+                ++k;
+            }
         }
-        for (auto kv : x.value().as_map()) {
-            pn::string_view k = kv.key();
-            path_value      v = x.get(k);
-            if (fields.find(k) == fields.end()) {
-                throw std::runtime_error(pn::format("{0}unknown field", v.prefix()).c_str());
+        for (; k != keys.end(); ++k) {
+            if (k->second < unknown_index) {
+                unknown_index = k->second;
+                unknown_key   = k->first;
             }
         }
+        if (unknown_index < values.size()) {
+            path_value v = x.get(unknown_key, values[unknown_index]);
+            throw std::runtime_error(pn::format("{0}unknown field", v.prefix()).c_str());
+        }
         return t;
     } else {
         throw std::runtime_error(
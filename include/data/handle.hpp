@@ -21,6 +21,7 @@
 
 #include <stdlib.h>
 #include <pn/string>
+#include <utility>
 
 namespace antares {
 
@@ -85,29 +86,44 @@ class HandleList {
     int _end;
 };
 
+// Returns a small integer that identifies `name`: equal names always get the same ID, and IDs
+// count up from zero in the order that names are first seen.
+int intern(pn::string_view name);
+
+// Refers to a piece of plugin data by name.  The name is interned on construction, so that
+// types which keep an ID-indexed table (see below) can resolve the handle without hashing or
+// comparing strings.
 template <typename T>
 class NamedHandle {
   public:
-    NamedHandle() : _name() {}
-    explicit NamedHandle(pn::string_view name) : _name(name.copy()) {}
-    NamedHandle     copy() const { return NamedHandle(_name.copy()); }
+    NamedHandle() : _name(), _id(intern(_name)) {}
+    explicit NamedHandle(pn::string_view name) : _name(name.copy()), _id(intern(name)) {}
+    NamedHandle     copy() const { return NamedHandle(_name.copy(), _id); }
     pn::string_view name() const { return _name; }
+    int             id() const { return _id; }
     T*              get() const { return T::get(_name); }
     T&              operator*() const { return *get(); }
     T*              operator->() const { return get(); }
 
   private:
+    NamedHandle(pn::string name, int id) : _name(std::move(name)), _id(id) {}
+
     pn::string _name;
+    int        _id;
 };
 template <typename T>
-inline bool operator==(NamedHandle<T> x, NamedHandle<T> y) {
-    return x.name() == y.name();
+inline bool operator==(const NamedHandle<T>& x, const NamedHandle<T>& y) {
+    return x.id() == y.id();
 }
 template <typename T>
-inline bool operator!=(NamedHandle<T> x, NamedHandle<T> y) {
+inline bool operator!=(const NamedHandle<T>& x, const NamedHandle<T>& y) {
     return !(x == y);
 }
 
+// Base objects are looked up on every dereference, so they are resolved by ID.
+template <>
+const BaseObject* NamedHandle<const BaseObject>::get() const;
+
 }  // namespace antares
 
 #endif  // ANTARES_DATA_HANDLE_HPP_
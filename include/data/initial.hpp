@@ -32,9 +32,19 @@ class path_value;
 
 const int32_t kMaxShipCanBuild = 6;
 
-// Might be the name of a BaseObject, or of an entry in a Race’s “ships” list.
+// Might be the name of a BaseObject, or of an entry in a Race’s “ships” list.  `id` is the
+// interned name, set when the name is read, so that finding the object to build doesn't have to
+// look the name up.
 struct BuildableObject {
     pn::string name;
+    int        id;
+
+    BuildableObject() : BuildableObject(pn::string{}) {}
+    explicit BuildableObject(pn::string name) : name(std::move(name)), id(intern(this->name)) {}
+    BuildableObject copy() const { return BuildableObject(name.copy(), id); }
+
+  private:
+    BuildableObject(pn::string name, int id) : name(std::move(name)), id(id) {}
 };
 
 struct Initial {
@@ -150,6 +150,10 @@ union Level {
 };
 Level level(pn::value_cref x);
 
+// Reads just the chapter number of level `x`.  The rest of the level isn't checked until it is
+// read in full with level().
+sfz::optional<int64_t> level_chapter(pn::value_cref x);
+
 }  // namespace antares
 
 #endif  // ANTARES_DATA_LEVEL_HPP_
@@ -20,6 +20,7 @@
 #define ANTARES_DATA_PLUGIN_HPP_
 
 #include <map>
+#include <set>
 #include <sfz/sfz.hpp>
 #include <vector>
 
@@ -37,16 +38,31 @@ class BaseObject;
 union Level;
 struct Race;
 
+// Data read from the current plugin.
+//
+// The maps here are keyed by name, but nothing looks them up by name while a level is running:
+// base objects are reached through `object_ids`, and races are only used while a level is being
+// set up.  So there would be little to gain from a hash map.  Nor from an arena: `objects` and
+// `races` hold one level's worth of data, a few hundred entries at most, and an arena would mean
+// giving BaseObject's members a custom allocator.
 struct ScenarioGlobals {
     sfz::optional<pn::string>          dir;
     std::unique_ptr<zipxx::ZipArchive> zip;
 
     Info                             info;
+    std::set<pn::string>             level_names;
     std::map<int, pn::string>        chapters;
-    std::map<pn::string, Level>      levels;
+    std::map<pn::string, Level>      levels;  // read on first use, by Level::get().
+    // Races and objects used by the current level.  They are cleared when a level starts, and not
+    // kept for the next: level setup treats an object that is already loaded as one whose
+    // sprites and sounds are also loaded.
     std::map<pn::string, BaseObject> objects;
     std::map<pn::string, Race>       races;
 
+    std::vector<BaseObject*> object_ids;  // `objects`, indexed by NamedHandle::id().
+
+    std::map<pn::string, int> tag_numbers;  // bit numbers for Tags, up to kMaxTags.
+
     Texture splash;
     Texture starmap;
 };
@@ -21,6 +21,7 @@
 
 #include <stdint.h>
 #include <pn/string>
+#include <sfz/sfz.hpp>
 #include <vector>
 
 namespace antares {
@@ -40,6 +41,7 @@ struct SpriteData;
 
 class Resource {
   public:
+    static void                    build_index();
     static std::vector<pn::string> list_levels();
     static std::vector<pn::string> list_replays();
     static bool                    object_exists(pn::string_view name);
@@ -49,6 +51,7 @@ class Resource {
     static Info                    info();
     static InterfaceData           interface(pn::string_view name);
     static Level                   level(pn::string_view path);
+    static sfz::optional<int64_t>  level_chapter(pn::string_view path);
     static SoundData               music(pn::string_view name);
     static BaseObject              object(pn::string_view path);
     static Race                    race(pn::string_view path);
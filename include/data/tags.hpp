@@ -21,6 +21,8 @@
 
 #include <stdint.h>
 
+#include <bitset>
+#include <map>
 #include <memory>
 #include <pn/string>
 #include <sfz/sfz.hpp>
@@ -37,6 +39,10 @@
 
 namespace antares {
 
+// Tag names are numbered as they are read, per plugin (see ScenarioGlobals::tag_numbers).  This
+// many get a number; any others are still read, but matched by name.
+const int kMaxTags = 128;
+
 struct Tags {
     Tags()            = default;
     Tags(const Tags&) = delete;
@@ -49,10 +55,20 @@ struct Tags {
     // The issue is in libstdc++ 5.4.0 but is fixed by 9.3.0.
     Tags& operator=(Tags&& other) {
         std::swap(tags, other.tags);
+        mask       = other.mask;
+        set        = other.set;
+        unnumbered = other.unnumbered;
         return *this;
     }
 
     std::map<pn::string, bool> tags;
+
+    // The same as `tags`, by tag number: `mask` has a bit for each tag in `tags`, and `set` has
+    // the bits for tags whose value is true.  If `unnumbered`, some tags were read after the
+    // plugin ran out of numbers, and have no bits.
+    std::bitset<kMaxTags> mask;
+    std::bitset<kMaxTags> set;
+    bool                  unnumbered = false;
 };
 
 }  // namespace antares
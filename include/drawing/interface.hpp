@@ -28,11 +28,14 @@
 namespace antares {
 
 class Font;
+class StyledText;
 
 const int32_t kInterfaceTextVBuffer = 2;
 const int32_t kInterfaceTextHBuffer = 3;
 
 const Font& interface_font(InterfaceStyle style);
+StyledText  interface_text(pn::string_view text, InterfaceStyle style, Hue hue, int32_t width);
+void        draw_text_in_rect(Rect tRect, const StyledText& text);
 void        draw_text_in_rect(Rect tRect, pn::string_view text, InterfaceStyle style, Hue hue);
 int16_t GetInterfaceTextHeightFromWidth(pn::string_view text, InterfaceStyle style, int16_t width);
 
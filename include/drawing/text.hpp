@@ -19,6 +19,7 @@
 #ifndef ANTARES_DRAWING_TEXT_HPP_
 #define ANTARES_DRAWING_TEXT_HPP_
 
+#include <array>
 #include <pn/string>
 
 #include "drawing/sprite-handling.hpp"
@@ -55,6 +56,7 @@ class Font {
     Rect glyph_rect(pn::rune rune) const;
 
     std::map<pn::rune, Rect> _glyphs;
+    std::array<Rect, 128>    _ascii_glyphs;  // glyph_rect() for ASCII, without the map lookup
 };
 
 Font font(pn::string_view name);
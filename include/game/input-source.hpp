@@ -20,8 +20,7 @@
 #define ANTARES_GAME_INPUT_SOURCE_HPP_
 
 #include <stdint.h>
-#include <map>
-#include <memory>
+#include <vector>
 
 #include "config/keys.hpp"
 #include "data/handle.hpp"
@@ -31,6 +30,57 @@ namespace antares {
 
 struct ReplayData;
 
+// A queue of input events, each to be delivered to one admiral on one major tick.  Events are
+// stored by value in a flat array, in the order they are to be delivered, with a cursor marking
+// the first that hasn't been delivered yet.
+class InputQueue {
+  public:
+    InputQueue() : _next(0) {}
+
+    void clear();
+    void reserve(size_t n) { _events.reserve(n); }
+
+    // Appends an event.  Events must be pushed in order of `at`.
+    void push(int admiral, game_ticks at, const Event& event);
+
+    // Sends `receiver` all events for `admiral` at `at`.  Calls must be in order of `at`; events
+    // before `at` are skipped over and never sent.
+    void send(int admiral, game_ticks at, EventReceiver& receiver);
+
+    // Frees the space taken by events before `at`.
+    void drop_before(game_ticks at);
+
+  private:
+    struct Entry {
+        enum Type {
+            KEY_DOWN,
+            KEY_UP,
+            GAMEPAD_BUTTON_DOWN,
+            GAMEPAD_BUTTON_UP,
+            GAMEPAD_STICK,
+            MOUSE_DOWN,
+            MOUSE_UP,
+            MOUSE_MOVE,
+        };
+
+        int        admiral;
+        game_ticks at;
+        Type       type;
+        wall_time  event_at;
+        int        value;  // key, gamepad button or stick, or mouse button.
+        int        count;  // mouse click count.
+        Point      where;  // mouse position.
+        double     x, y;   // stick position.
+
+        void send(EventReceiver& receiver) const;
+    };
+
+    class Pusher;
+
+    std::vector<Entry> _events;
+    size_t             _next;
+};
+
 class InputSource : public EventReceiver {
   public:
     InputSource() {}
@@ -59,7 +109,7 @@ class RealInputSource : public InputSource {
   private:
     static game_ticks at();
 
-    std::multimap<std::pair<int, game_ticks>, std::unique_ptr<Event>> _events;
+    InputQueue _events;
 };
 
 class ReplayInputSource : public InputSource {
@@ -76,9 +126,9 @@ class ReplayInputSource : public InputSource {
   private:
     bool advance(EventReceiver& receiver);
 
-    game_ticks                                                        _duration;
-    std::multimap<std::pair<int, game_ticks>, std::unique_ptr<Event>> _events;
-    bool                                                              _exit;
+    game_ticks _duration;
+    InputQueue _events;
+    bool       _exit;
 };
 
 }  // namespace antares
@@ -114,30 +114,58 @@ class SpaceObject {
     pn::string_view short_name() const;
     bool            engages(const SpaceObject& b) const;
     Fixed           turn_rate() const;
+    int32_t         number() const;
+
+    // State read on every tick by MoveSpaceObjects() and by the collision grid in
+    // CollideSpaceObjects(). It's kept together at the front of the object so that those loops,
+    // which visit every active object several times per tick, touch as few cache lines as
+    // possible.
+    int16_t             active     = kObjectAvailable;
+    uint32_t            attributes = 0;
+    Handle<Admiral>     owner;
+    Handle<SpaceObject> nextObject;
+    Handle<SpaceObject> nextNearObject;
+    Handle<SpaceObject> nextFarObject;
+
+    Point location = {0, 0};  // [1073610752..1073872896), or [0x3ffe0000..0x40020000)
+    Point collisionGrid;      // [524224..524352), or [0x7ffc0..0x80040)
+    Point distanceGrid;       // [32764..32772), or [0x7ffc..0x8004)
+
+    fixedPointType motionFraction = {Fixed::zero(), Fixed::zero()};
+    fixedPointType velocity       = {Fixed::zero(), Fixed::zero()};
+    Fixed          thrust         = Fixed::zero();
+    Fixed          maxVelocity    = Fixed::zero();
+    Rect           absoluteBounds;
+
+    int32_t direction    = 0;
+    Fixed   turnVelocity = Fixed::zero();
+    Fixed   turnFraction = Fixed::zero();
+
+    kPresenceStateType presenceState = kNormalPresence;
+    union {
+        struct {
+            int16_t speed;
+            Scale   scale;
+        } landing;
+        struct {
+            uint8_t step;
+            ticks   progress;
+        } warp_in;
+        Fixed warping;
+        Fixed warp_out;
+    } presence;
 
-    uint32_t          attributes = 0;
-    const BaseObject* base       = nullptr;
-    int32_t           number() const;
+    // Everything below is cold, as far as motion and the collision grid are concerned.
+    const BaseObject* base = nullptr;
 
     uint32_t keysDown = 0;
 
     sfz::optional<BaseObject::Icon> icon;
 
-    int32_t direction     = 0;
     int32_t directionGoal = 0;
-    Fixed   turnVelocity  = Fixed::zero();
-    Fixed   turnFraction  = Fixed::zero();
+    int32_t offlineTime   = 0;
 
-    int32_t offlineTime = 0;
-
-    Point location = {0, 0};  // [1073610752..1073872896), or [0x3ffe0000..0x40020000)
-    Point collisionGrid;      // [524224..524352), or [0x7ffc0..0x80040)
-    Point distanceGrid;       // [32764..32772), or [0x7ffc..0x8004)
-
-    Handle<SpaceObject> nextNearObject;
-    Handle<SpaceObject> nextFarObject;
     Handle<SpaceObject> previousObject;
-    Handle<SpaceObject> nextObject;
 
     int32_t runTimeFlags        = 0;       // distance from origin to destination
     Point   destinationLocation = {0, 0};  // coords of our destination ( or kNoDestination)
@@ -162,12 +190,7 @@ class SpaceObject {
             Fixed::zero(), Fixed::zero()};  // calced when we got origin
     Point originLocation = {0, 0};          // coords of our origin
 
-    fixedPointType motionFraction = {Fixed::zero(), Fixed::zero()};
-    fixedPointType velocity       = {Fixed::zero(), Fixed::zero()};
-    Fixed          thrust         = Fixed::zero();
-    Fixed          maxVelocity    = Fixed::zero();
-    Rect           absoluteBounds;
-    Random         randomSeed;
+    Random randomSeed;
 
     struct {
         struct {
@@ -201,13 +224,11 @@ class SpaceObject {
     void    refund_warp_energy();
     int32_t warpEnergyCollected = 0;
 
-    Handle<Admiral> owner;
-    bool            expires      = false;
-    ticks           expire_after = ticks(-1);
-    Scale           naturalScale = SCALE_SCALE;
-    int32_t         id           = kNoShip;
-    ticks           rechargeTime = ticks(0);
-    int16_t         active       = kObjectAvailable;
+    bool    expires      = false;
+    ticks   expire_after = ticks(-1);
+    Scale   naturalScale = SCALE_SCALE;
+    int32_t id           = kNoShip;
+    ticks   rechargeTime = ticks(0);
 
     BaseObject::Layer layer = BaseObject::Layer::NONE;
     Handle<Sprite>    sprite;
@@ -224,20 +245,6 @@ class SpaceObject {
     int32_t             shortestWeaponRange = 0;
     int32_t             engageRange         = kEngageRange;  // longestWeaponRange or kEngageRange
 
-    kPresenceStateType presenceState = kNormalPresence;
-    union {
-        struct {
-            int16_t speed;
-            Scale   scale;
-        } landing;
-        struct {
-            uint8_t step;
-            ticks   progress;
-        } warp_in;
-        Fixed warping;
-        Fixed warp_out;
-    } presence;
-
     int32_t  hitState   = 0;
     int32_t  cloakState = 0;
     dutyType duty       = eNoDuty;
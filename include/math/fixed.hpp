@@ -102,6 +102,17 @@ inline int32_t evil_fixed_to_long(Fixed value) {
 }
 inline int32_t more_evil_fixed_to_long(Fixed value) { return (value >> 8).val(); }
 
+// Round a fixed-point number to the nearest int32_t, with halves rounding up (towards positive
+// infinity).  This is what the motion code has always computed as
+//
+//     value >= 0 ? more_evil_fixed_to_long(value + 0.5)
+//                : more_evil_fixed_to_long(value - 0.5) + 1
+//
+// but without the branch, since the two arms agree for every input that doesn't overflow.
+inline int32_t rounded_fixed_to_long(Fixed value) {
+    return more_evil_fixed_to_long(value + Fixed::from_float(0.5));
+}
+
 inline float   mFixedToFloat(Fixed m_f) { return floorf(m_f.val() * 1e3 / 256.0) / 1e3; }
 inline int32_t mFixedToLong(Fixed m_f) { return evil_fixed_to_long(m_f); }
 
@@ -64,7 +64,12 @@ inline void mAddAngle(T& theta, int32_t other) {
     }
 }
 
-void    GetRotPoint(Fixed* x, Fixed* y, int32_t rotpos);
+void GetRotPoint(Fixed* x, Fixed* y, int32_t rotpos);
+
+// Searches `sys.rot_table` for the angle nearest to the vector (x, y).  This takes up to 45 steps,
+// but it's only used for gamepad input, once per stick event.  Code that runs every tick, such as
+// steering and thrust, uses ratio_to_angle() from math/special.hpp, which is a binary search over
+// a slope table.
 int32_t GetAngleFromVector(int32_t x, int32_t y);
 
 }  // namespace antares
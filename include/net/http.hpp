@@ -19,12 +19,19 @@
 #ifndef ANTARES_NET_HTTP_HPP_
 #define ANTARES_NET_HTTP_HPP_
 
+#include <stdint.h>
+#include <functional>
 #include <pn/fwd>
 
 namespace antares {
 namespace http {
 
-void get(pn::string_view url, pn::output_view out);
+// Fetches `url`, passing the response body to `write` piece by piece as it arrives.
+//
+// If `offset` is nonzero, only the part of the body from byte `offset` on is passed to `write`.
+// The server is asked for just that range; if it sends the whole body anyway, the first `offset`
+// bytes are dropped.  If `offset` is already past the end of the body, nothing is written.
+void get(pn::string_view url, int64_t offset, const std::function<void(pn::data_view)>& write);
 
 }  // namespace http
 }  // namespace antares
@@ -0,0 +1,149 @@
+// Copyright (C) 2018 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_NET_LOCKSTEP_HPP_
+#define ANTARES_NET_LOCKSTEP_HPP_
+
+#include <stdint.h>
+#include <map>
+#include <pn/data>
+#include <sfz/sfz.hpp>
+#include <vector>
+
+#include "data/replay.hpp"
+#include "math/units.hpp"
+
+namespace antares {
+
+// Carries packets between the two peers of a net game.  Packets may be lost, duplicated, or
+// reordered, but arrive whole if they arrive at all.  Their contents aren't trusted.
+class LockstepTransport {
+  public:
+    virtual ~LockstepTransport();
+    virtual void send(pn::data_view packet) = 0;
+
+    // Sets `packet` to the next packet from the peer.  Returns false, without waiting, if none
+    // has arrived.
+    virtual bool receive(pn::data* packet) = 0;
+};
+
+// Exchanges input with the other peer of a two-player net game, one frame per major tick.
+//
+// Input made on tick `t` takes effect on tick `t + input_delay`, so the peer has that long to
+// receive it before it has to wait.  A higher delay hides more latency, at the cost of making
+// the controls feel sluggish.  For the first `input_delay` ticks, neither player has any input.
+//
+// Every packet repeats the oldest frames that the peer hasn't acknowledged yet, up to
+// `redundancy` of them, so that a lost packet is usually made up for by the next one instead of
+// by a resend.
+//
+// Each frame also carries the value of `g.sync` after the tick its input was made on.  When a
+// frame for a tick has arrived from both peers, their values are compared; if they differ, the
+// simulations have diverged, and there's no getting them back.
+//
+// A packet that doesn't parse, or that names ticks the peer couldn't have reached yet, is
+// dropped and counted in Stats::packets_dropped.  So a corrupt or forged packet can't end the
+// game, and the session never holds more than `2 * input_delay` frames from the future.
+//
+// Ticks here count major ticks from the start of the level.
+class LockstepSession {
+  public:
+    struct Stats {
+        sfz::optional<usecs> latency;  // round trip for the frame sent on this tick.
+        int64_t              packets_sent     = 0;
+        int64_t              bytes_sent       = 0;
+        int64_t              packets_received = 0;
+        int64_t              bytes_received   = 0;
+        int64_t              packets_dropped  = 0;
+    };
+
+    LockstepSession(LockstepTransport* transport, int64_t input_delay, int redundancy);
+    LockstepSession(const LockstepSession&) = delete;
+    LockstepSession& operator=(const LockstepSession&) = delete;
+
+    int64_t input_delay() const { return _input_delay; }
+
+    // Records the local player's input on `tick`, along with `sync` as it stands after that tick,
+    // and sends it to the peer.  Ticks must be pushed in order, starting from 0.
+    //
+    // Throws if the peer had already sent a different `sync` for the tick.
+    void push(int64_t tick, uint32_t sync, const ReplayData::Action& input, wall_time at);
+
+    // Handles any packets that have arrived from the peer.  If nothing has been sent for a major
+    // tick, also sends a packet, so that acknowledgements and lost frames get through while both
+    // peers are waiting on each other.
+    //
+    // Throws if the peer sent a different `sync` for a tick than was pushed locally, or if it
+    // uses a different input delay.
+    void poll(wall_time at);
+
+    // True if the peer's input for `tick` has arrived.  Local input is always available after
+    // the push() for `tick - input_delay()`.
+    bool ready(int64_t tick) const;
+
+    // The input that applies on `tick`, from this side or the peer.  `at` is set to `tick`.
+    const ReplayData::Action& local(int64_t tick) const;
+    const ReplayData::Action& remote(int64_t tick) const;
+
+    // Traffic while `tick` was the latest pushed, and the round trip time of the frame pushed on
+    // `tick` once the peer has acknowledged it.  Packets that arrive before the first push are
+    // counted against tick 0.
+    const Stats& stats(int64_t tick) const;
+
+  private:
+    struct Frame {
+        uint32_t           sync;
+        ReplayData::Action input;
+    };
+
+    struct Packet {
+        uint64_t           input_delay = 0;
+        uint64_t           ack         = 0;
+        std::vector<Frame> frames;
+    };
+
+    static bool read_packet(pn::data_view bytes, Packet* packet);
+    static bool read_frame(pn::data_view bytes, Frame* frame);
+
+    void   send(wall_time at);
+    void   receive(pn::data_view bytes, wall_time at);
+    void   check_sync(int64_t tick) const;
+    Stats& current_stats();
+
+    LockstepTransport* const _transport;
+    const int64_t            _input_delay;
+    const int                _redundancy;
+
+    // Local frames, indexed by the tick they apply on, and when each was first sent.
+    std::vector<Frame>     _local;
+    std::vector<wall_time> _sent;
+
+    // Remote frames, by the tick they apply on.  Frames before `_remote_next` have all arrived;
+    // any at or after it arrived out of order.
+    std::map<int64_t, Frame> _remote;
+    int64_t                  _remote_next;
+
+    // The first local frame that the peer hasn't acknowledged.
+    int64_t _acked;
+
+    std::vector<Stats>       _stats;
+    sfz::optional<wall_time> _last_send;
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_NET_LOCKSTEP_HPP_
@@ -0,0 +1,51 @@
+// Copyright (C) 2018 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_NET_UDP_HPP_
+#define ANTARES_NET_UDP_HPP_
+
+#include <stdint.h>
+#include <pn/fwd>
+
+#include "net/lockstep.hpp"
+
+namespace antares {
+
+// Sends lockstep packets as UDP datagrams to a single peer, over IPv4.
+class UdpTransport : public LockstepTransport {
+  public:
+    // Binds to `port` on `host`.  If `port` is 0, the system picks one; see port().
+    UdpTransport(pn::string_view host, int port);
+    UdpTransport(const UdpTransport&) = delete;
+    UdpTransport& operator=(const UdpTransport&) = delete;
+    ~UdpTransport();
+
+    int port() const;
+
+    // Sends to, and only accepts packets from, `port` on `host`.
+    void connect(pn::string_view host, int port);
+
+    virtual void send(pn::data_view packet);
+    virtual bool receive(pn::data* packet);
+
+  private:
+    int _fd;
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_NET_UDP_HPP_
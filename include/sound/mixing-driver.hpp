@@ -0,0 +1,72 @@
+// Copyright (C) 2018 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#ifndef ANTARES_SOUND_MIXING_DRIVER_HPP_
+#define ANTARES_SOUND_MIXING_DRIVER_HPP_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <memory>
+#include <vector>
+
+#include "sound/driver.hpp"
+
+namespace antares {
+
+struct SoundData;
+
+// Mixes sounds in software and writes the result to a WAV file (44.1 kHz, 16-bit stereo).
+//
+// Sounds are placed according to now(), so when the video driver runs on a simulated clock, as
+// it does when playing back replays, the audio follows the same clock and takes no longer to
+// produce than the mixing itself.
+class MixingSoundDriver : public SoundDriver {
+  public:
+    MixingSoundDriver(pn::string_view path);
+    MixingSoundDriver(const MixingSoundDriver&) = delete;
+    MixingSoundDriver& operator=(const MixingSoundDriver&) = delete;
+    ~MixingSoundDriver();
+
+    virtual std::unique_ptr<SoundChannel> open_channel();
+    virtual std::unique_ptr<Sound>        open_sound(pn::string_view path);
+    virtual std::unique_ptr<Sound>        open_music(pn::string_view path);
+    virtual void                          set_global_volume(uint8_t volume);
+
+    // Opens a sound that has already been read; open_sound() and open_music() read theirs with
+    // Resource and then call this.
+    std::unique_ptr<Sound> open_sound(SoundData data);
+
+  private:
+    class MixingChannel;
+    class MixingSound;
+    struct Voice;
+
+    void advance();
+    void catch_up();
+    void mix(int64_t frames);
+    void write_header();
+
+    std::unique_ptr<FILE, decltype(&fclose)> _file;
+    int64_t                                  _frames;  // frames written so far.
+    std::vector<std::shared_ptr<Voice>>      _voices;
+    std::shared_ptr<Voice>                   _active_voice;
+    uint8_t                                  _global_volume;
+};
+
+}  // namespace antares
+
+#endif  // ANTARES_SOUND_MIXING_DRIVER_HPP_
@@ -19,6 +19,7 @@
 #ifndef ANTARES_UI_WIDGET_HPP_
 #define ANTARES_UI_WIDGET_HPP_
 
+#include <memory>
 #include <vector>
 
 #include "data/interface.hpp"
@@ -80,6 +81,7 @@ class BoxRect : public Widget {
 class TextRect : public Widget {
   public:
     TextRect(const TextRectData& data);
+    ~TextRect();
 
     pn::string_view id() const override { return _id; }
 
@@ -96,6 +98,9 @@ class TextRect : public Widget {
     sfz::optional<pn::string> _text;
     Hue                       _hue   = Hue::GRAY;
     InterfaceStyle            _style = InterfaceStyle::LARGE;
+
+    // The text never changes, so it's laid out on the first draw and kept.
+    mutable std::unique_ptr<StyledText> _styled_text;
 };
 
 class PictureRect : public Widget {
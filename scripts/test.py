@@ -25,7 +25,9 @@ EXCEPT = "EXCEPT"
 WINE_TESTS = [
     "color-test",
     "editable-text-test",
+    "field-test",
     "fixed-test",
+    "lockstep-test",
     "object-data",
     "shapes",
     "tint",
@@ -155,7 +157,11 @@ def main():
     tests = [
         (unit_test, opts, queue, "color-test"),
         (unit_test, opts, queue, "editable-text-test"),
+        (unit_test, opts, queue, "field-test"),
         (unit_test, opts, queue, "fixed-test"),
+        (unit_test, opts, queue, "http-test"),
+        (unit_test, opts, queue, "lockstep-test"),
+        (unit_test, opts, queue, "mixing-driver-test"),
         (data_test, opts, queue, "build-pix", ["--text"]),
         (data_test, opts, queue, "object-data"),
         (data_test, opts, queue, "shapes"),
@@ -48,11 +48,19 @@ namespace {
 class DrawPix : public Card {
   public:
     DrawPix(std::function<pn::string_view()> text, int32_t width,
-            std::function<void(Rect)> set_capture_rect)
-            : _set_capture_rect(set_capture_rect), _text(text), _width(width) {}
+            std::function<void(Rect)> set_capture_rect, bool* plugin_loaded)
+            : _set_capture_rect(set_capture_rect),
+              _text(text),
+              _width(width),
+              _plugin_loaded(plugin_loaded) {}
 
     virtual void draw() const {
-        PluginInit(sfz::nullopt);
+        // The plugin can't be loaded before the first draw, because loading it creates textures.
+        // After that, all images share it; loading it again would re-read every level.
+        if (!*_plugin_loaded) {
+            PluginInit(sfz::nullopt);
+            *_plugin_loaded = true;
+        }
         BuildPix pix(sys.fonts.title, _text(), _width);
         pix.draw({0, 0});
         _set_capture_rect({0, 0, _width, pix.size().height});
@@ -62,6 +70,7 @@ class DrawPix : public Card {
     const std::function<void(Rect)>        _set_capture_rect;
     const std::function<pn::string_view()> _text;
     const int32_t                          _width;
+    bool* const                            _plugin_loaded;
 };
 
 void usage(pn::output_view out, pn::string_view progname, int retcode) {
@@ -86,13 +95,13 @@ pn::string_view about() { return *plug.info.about; }
 
 std::function<pn::string_view()> prologue(pn::string_view chapter) {
     return [chapter]() -> pn::string_view {
-        return *plug.levels.find(chapter.copy())->second.solo.prologue;
+        return *Level::get(chapter)->solo.prologue;
     };
 }
 
 std::function<pn::string_view()> epilogue(pn::string_view chapter) {
     return [chapter]() -> pn::string_view {
-        return *plug.levels.find(chapter.copy())->second.solo.epilogue;
+        return *Level::get(chapter)->solo.epilogue;
     };
 }
 
@@ -143,10 +152,12 @@ void run(
              }},
     };
 
+    bool                                       plugin_loaded = false;
     vector<pair<unique_ptr<Card>, pn::string>> pix;
     for (const auto& spec : specs) {
         pix.emplace_back(
-                unique_ptr<Card>(new DrawPix(spec.text, spec.width, set_capture_rect)),
+                unique_ptr<Card>(
+                        new DrawPix(spec.text, spec.width, set_capture_rect, &plugin_loaded)),
                 pn::format("{0}.{1}", spec.name, extension));
     }
     video->capture(pix);
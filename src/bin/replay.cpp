@@ -46,6 +46,7 @@
 #include "math/random.hpp"
 #include "math/rotation.hpp"
 #include "sound/driver.hpp"
+#include "sound/mixing-driver.hpp"
 #include "sound/music.hpp"
 #include "ui/card.hpp"
 #include "ui/interface-handling.hpp"
@@ -160,6 +161,7 @@ void usage(pn::output_view out, pn::string_view progname, int retcode) {
             "\n    -w, --width=WIDTH    screen width (default: 640)"
             "\n    -h, --height=HEIGHT  screen height (default: 480)"
             "\n    -t, --text           produce text output"
+            "\n    -a, --audio          mix sounds into sound.wav, instead of logging them"
             "\n    -s, --smoke          run as smoke text"
             "\n        --opengl=2.0|3.2 select OpenGL version (default: 3.2)"
             "\n        --help           display this help screen"
@@ -186,6 +188,7 @@ void main(int argc, char* const* argv) {
     int                       width        = 640;
     int                       height       = 480;
     bool                      text         = false;
+    bool                      audio        = false;
     bool                      smoke        = false;
     std::pair<int, int>       gl_version   = {3, 2};
     pn::string_view           glsl_version = "330 core";
@@ -196,6 +199,7 @@ void main(int argc, char* const* argv) {
             case 'w': sfz::args::integer_option(get_value(), &width); return true;
             case 'h': sfz::args::integer_option(get_value(), &height); return true;
             case 't': text = true; return true;
+            case 'a': audio = true; return true;
             case 's': smoke = true; return true;
             default: return false;
         }
@@ -213,6 +217,8 @@ void main(int argc, char* const* argv) {
             return callbacks.short_option(pn::rune{'h'}, get_value);
         } else if (opt == "text") {
             return callbacks.short_option(pn::rune{'t'}, get_value);
+        } else if (opt == "audio") {
+            return callbacks.short_option(pn::rune{'a'}, get_value);
         } else if (opt == "smoke") {
             return callbacks.short_option(pn::rune{'s'}, get_value);
         } else if (opt == "opengl") {
@@ -255,7 +261,10 @@ void main(int argc, char* const* argv) {
     }
 
     unique_ptr<SoundDriver> sound;
-    if (!smoke && output_dir.has_value()) {
+    if (!smoke && output_dir.has_value() && audio) {
+        pn::string out = pn::format("{0}/sound.wav", *output_dir);
+        sound.reset(new MixingSoundDriver(out));
+    } else if (!smoke && output_dir.has_value()) {
         pn::string out = pn::format("{0}/sound.log", *output_dir);
         sound.reset(new LogSoundDriver(out));
     } else {
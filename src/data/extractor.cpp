@@ -21,7 +21,10 @@
 #include <fcntl.h>
 #include <math.h>
 #include <stdint.h>
+#include <stdio.h>
 
+#include <memory>
+#include <vector>
 #include <pn/array>
 #include <pn/output>
 #include <pn/string>
@@ -256,39 +259,92 @@ void DataExtractor::download(
         rmtree(full_path);
     }
 
-    pn::string url = pn::format("{0}/{1}/{1}-{2}.zip", base, name, version);
+    pn::string url       = pn::format("{0}/{1}/{1}-{2}.zip", base, name, version);
+    pn::string part_path = pn::format("{0}.part", full_path);
+    makedirs(path::dirname(full_path), 0755);
+
+    // If an earlier download was interrupted, keep what it got, and ask only for the rest.
+    sha1    sha;
+    int64_t size = 0;
+    if (path::isfile(part_path)) {
+        std::unique_ptr<FILE, decltype(&fclose)> part(fopen(part_path.c_str(), "rb"), fclose);
+        if (!part) {
+            throw std::runtime_error(pn::format("{0}: couldn't open", part_path).c_str());
+        }
+        uint8_t buf[64 * 1024];
+        size_t  n;
+        while ((n = fread(buf, 1, sizeof(buf), part.get())) > 0) {
+            sha.write(pn::data_view{buf, static_cast<int>(n)});
+            size += n;
+        }
+    } else if (path::exists(part_path)) {
+        rmtree(part_path);
+    }
 
     pn::string status = pn::format("Downloading {0}-{1}.zip...", name, version);
     observer->status(status);
 
-    // Download the file from `url`.  Check its digest when it has been downloaded; if it is not
-    // the right file, then throw an exception without writing it to disk.  Otherwise, write it to
-    // disk.
-    pn::data download;
-    http::get(url, download.output());
-    sha1 sha;
-    sha.write(download);
+    // Download the rest of the file from `url`, appending it to `part_path` and hashing it as it
+    // arrives, so the archive is never held in memory.  Report progress every megabyte.
+    {
+        std::unique_ptr<FILE, decltype(&fclose)> part(fopen(part_path.c_str(), "ab"), fclose);
+        if (!part) {
+            throw std::runtime_error(
+                    pn::format("{0}: couldn't open for writing", part_path).c_str());
+        }
+        const int64_t kProgressStep = 1024 * 1024;
+        int64_t       reported      = size / kProgressStep;
+        bool          write_failed  = false;
+        http::get(url, size, [&](pn::data_view data) {
+            if (write_failed) {
+                return;
+            } else if (fwrite(data.data(), 1, data.size(), part.get()) != data.size()) {
+                write_failed = true;
+                return;
+            }
+            sha.write(data);
+            size += data.size();
+            if ((size / kProgressStep) > reported) {
+                reported = size / kProgressStep;
+                observer->status(pn::format(
+                        "Downloading {0}-{1}.zip... {2} MB", name, version, reported));
+            }
+        });
+        if (write_failed || (fclose(part.release()) != 0)) {
+            throw std::runtime_error(pn::format("{0}: couldn't write", part_path).c_str());
+        }
+    }
+
+    // Check the digest of the whole file.  If it is not the right file, then throw an exception
+    // and discard it, so the next attempt starts over.  Otherwise, move it into place.
     if (sha.compute() != expected_digest) {
+        rmtree(part_path);
         throw std::runtime_error(
                 pn::format(
                         "Downloaded {0}, size={1} but it didn't have the right digest.",
-                        pn::dump(url, pn::dump_short), download.size())
+                        pn::dump(url, pn::dump_short), size)
                         .c_str());
     }
-
-    // If we got the file, write it out at `full_path`.
-    makedirs(path::dirname(full_path), 0755);
-    pn::output{full_path, pn::binary}.write(download).check();
+    if (rename(part_path.c_str(), full_path.c_str()) != 0) {
+        throw std::runtime_error(
+                pn::format("{0}: couldn't rename to {1}", part_path, full_path).c_str());
+    }
 }
 
 void DataExtractor::extract_original(Observer* observer, pn::string_view file) const {
-    pn::string status = pn::format("Extracting {0}...", file);
-    observer->status(status);
     pn::string full_path = pn::format("{0}/{1}", _downloads_dir, file);
     ZipArchive archive(full_path, 0);
 
-    ZipFileReader zip(archive, kAresSounds);
+    // Convert and check every sound before writing any of them.  The sounds are small, so holding
+    // all of them is cheap, and a bad archive then leaves nothing behind that current() would
+    // mistake for a finished extraction.
+    ZipFileReader         zip(archive, kAresSounds);
+    const int             count = sizeof(kNonFreeSounds) / sizeof(kNonFreeSounds[0]);
+    std::vector<pn::data> sounds;
+    sounds.reserve(count);
     for (const SoundInfo& info : kNonFreeSounds) {
+        observer->status(pn::format(
+                "Extracting {0}... ({1}/{2})", file, static_cast<int>(sounds.size()) + 1, count));
         pn::data data = convert_snd(info, zip.data());
 
         sha1 sha;
@@ -296,11 +352,21 @@ void DataExtractor::extract_original(Observer* observer, pn::string_view file) c
         if (sha.compute() != info.digest) {
             throw std::runtime_error(pn::format("sound {0}: digest mismatch", info.name).c_str());
         }
+        sounds.push_back(std::move(data));
+    }
 
-        pn::string output = pn::format(
-                "{0}/{1}/sounds/{2}.aiff", _output_dir, kFactoryScenarioIdentifier, info.name);
+    // Write them to a staging directory, and move it into place only once all are written.
+    pn::string scenario_dir = pn::format("{0}/{1}", _output_dir, kFactoryScenarioIdentifier);
+    pn::string staging_dir  = pn::format("{0}.part", scenario_dir);
+    rmtree(staging_dir);
+    for (int i = 0; i < sounds.size(); ++i) {
+        pn::string output = pn::format("{0}/sounds/{1}.aiff", staging_dir, kNonFreeSounds[i].name);
         makedirs(path::dirname(output), 0755);
-        pn::output(output, pn::binary).write(data).check();
+        pn::output(output, pn::binary).write(sounds[i]).check();
+    }
+    if (rename(staging_dir.c_str(), scenario_dir.c_str()) != 0) {
+        throw std::runtime_error(
+                pn::format("{0}: couldn't rename to {1}", staging_dir, scenario_dir).c_str());
     }
 }
 
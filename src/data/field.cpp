@@ -18,9 +18,13 @@
 
 #include "data/field.hpp"
 
+#include <deque>
+#include <map>
 #include <set>
 
 #include "data/level.hpp"
+#include "data/plugin.hpp"
+#include "lang/defines.hpp"
 
 namespace antares {
 
@@ -37,6 +41,38 @@ pn::string_view type_string(pn::value_cref x) {
     };
 }
 
+pn::value_cref null_value() {
+    static const pn::value null;
+    return null;
+}
+
+namespace {
+
+struct StructScratch {
+    std::vector<pn::value_cref>                      values;
+    std::vector<std::pair<pn::string_view, size_t>> keys;
+};
+
+// One entry per level of nesting reached so far; a deque, so that adding a level doesn't move
+// the scratch space of the levels already in use.
+ANTARES_GLOBAL std::deque<StructScratch> struct_scratch_pool;
+ANTARES_GLOBAL size_t                    struct_scratch_depth = 0;
+
+}  // namespace
+
+struct_scratch::struct_scratch() {
+    if (struct_scratch_depth == struct_scratch_pool.size()) {
+        struct_scratch_pool.emplace_back();
+    }
+    StructScratch& s = struct_scratch_pool[struct_scratch_depth++];
+    s.values.clear();
+    s.keys.clear();
+    values = &s.values;
+    keys   = &s.keys;
+}
+
+struct_scratch::~struct_scratch() { --struct_scratch_depth; }
+
 pn::string path_value::path() const {
     if (_parent && (_parent->_kind != Kind::ROOT)) {
         if (_kind == Kind::KEY) {
@@ -349,6 +385,21 @@ DEFINE_FIELD_READER(sfz::optional<secs>) {
     }
 }
 
+// Returns the number of tag `name` in the current plugin, or -1 if all kMaxTags numbers are
+// taken by other tags.
+static int tag_number(pn::string_view name) {
+    auto& numbers = plug.tag_numbers;
+    auto  it      = numbers.find(name.copy());
+    if (it != numbers.end()) {
+        return it->second;
+    } else if (numbers.size() >= kMaxTags) {
+        return -1;
+    }
+    int number = numbers.size();
+    numbers.emplace(name.copy(), number);
+    return number;
+}
+
 DEFINE_FIELD_READER(Tags) {
     if (x.value().is_null()) {
         return {};
@@ -358,7 +409,14 @@ DEFINE_FIELD_READER(Tags) {
         for (auto kv : m) {
             auto v = read_field<sfz::optional<bool>>(x.get(kv.key()));
             if (v.has_value()) {
+                int number                   = tag_number(kv.key());
                 result.tags[kv.key().copy()] = *v;
+                if (number < 0) {
+                    result.unnumbered = true;
+                } else {
+                    result.mask[number] = true;
+                    result.set[number]  = *v;
+                }
             }
         }
         return result;
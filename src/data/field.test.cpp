@@ -0,0 +1,130 @@
+// Copyright (C) 2018 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "data/field.hpp"
+
+#include <gmock/gmock.h>
+#include <pn/input>
+
+namespace antares {
+
+struct Inner {
+    int64_t x;
+};
+
+struct Outer {
+    int64_t                b;
+    sfz::optional<int64_t> d;
+    sfz::optional<int64_t> f;
+    Inner                  inner;
+};
+
+FIELD_READER(Inner) { return required_struct<Inner>(x, {{"x", &Inner::x}}); }
+
+namespace {
+
+using ::testing::Eq;
+
+using FieldTest = testing::Test;
+
+pn::value parse(pn::string_view text) {
+    pn::value  x;
+    pn_error_t e;
+    if (!pn::parse(text.input(), &x, &e)) {
+        throw std::runtime_error(
+                pn::format("{0}:{1}: {2}", e.lineno, e.column, pn_strerror(e.code)).c_str());
+    }
+    return x;
+}
+
+Outer read_outer(pn::string_view text) {
+    pn::value x = parse(text);
+    return required_struct<Outer>(
+            path_value{x}, {{"b", &Outer::b},
+                            {"c", nullptr},
+                            {"d", &Outer::d},
+                            {"f", &Outer::f},
+                            {"inner", &Outer::inner}});
+}
+
+pn::string read_error(pn::string_view text) {
+    try {
+        read_outer(text);
+    } catch (std::runtime_error& e) {
+        return e.what();
+    }
+    return "no error";
+}
+
+TEST_F(FieldTest, AllFields) {
+    Outer o = read_outer("b: 1\nc: 2\nd: 3\nf: 4\ninner: {x: 5}\n");
+    EXPECT_THAT(o.b, Eq(1));
+    ASSERT_THAT(o.d.has_value(), Eq(true));
+    EXPECT_THAT(*o.d, Eq(3));
+    ASSERT_THAT(o.f.has_value(), Eq(true));
+    EXPECT_THAT(*o.f, Eq(4));
+    EXPECT_THAT(o.inner.x, Eq(5));
+}
+
+TEST_F(FieldTest, KeyOrder) {
+    // Keys need not appear in the same order as the fields.
+    Outer o = read_outer("inner: {x: 5}\nf: 4\nb: 1\nd: 3\n");
+    EXPECT_THAT(o.b, Eq(1));
+    ASSERT_THAT(o.d.has_value(), Eq(true));
+    EXPECT_THAT(*o.d, Eq(3));
+    ASSERT_THAT(o.f.has_value(), Eq(true));
+    EXPECT_THAT(*o.f, Eq(4));
+    EXPECT_THAT(o.inner.x, Eq(5));
+}
+
+TEST_F(FieldTest, MissingKeys) {
+    // An absent field reads as null, which is fine for optional fields and for ignored ones.
+    Outer o = read_outer("b: 1\ninner: {x: 5}\n");
+    EXPECT_THAT(o.b, Eq(1));
+    EXPECT_THAT(o.d.has_value(), Eq(false));
+    EXPECT_THAT(o.f.has_value(), Eq(false));
+
+    EXPECT_THAT(read_error("inner: {x: 5}\n"), Eq("b: must be int (was null)"));
+    EXPECT_THAT(read_error("b: 1\ninner: {}\n"), Eq("inner.x: must be int (was null)"));
+    EXPECT_THAT(read_error("b: 1\n"), Eq("inner: must be map (was null)"));
+    EXPECT_THAT(read_error("1\n"), Eq("must be map (was int)"));
+}
+
+TEST_F(FieldTest, ExtraKeys) {
+    EXPECT_THAT(read_error("a: 0\nb: 1\ninner: {x: 5}\n"), Eq("a: unknown field"));
+    EXPECT_THAT(read_error("b: 1\ne: 0\ninner: {x: 5}\n"), Eq("e: unknown field"));
+    EXPECT_THAT(read_error("b: 1\ninner: {x: 5}\nz: 0\n"), Eq("z: unknown field"));
+    EXPECT_THAT(read_error("b: 1\ninner: {x: 5, y: 6}\n"), Eq("inner.y: unknown field"));
+
+    // With several unknown keys, the first in the file is reported, not the first in sort order.
+    EXPECT_THAT(read_error("z: 0\nb: 1\na: 0\ninner: {x: 5}\n"), Eq("z: unknown field"));
+    EXPECT_THAT(read_error("b: 1\ne: 0\ninner: {x: 5}\na: 0\n"), Eq("e: unknown field"));
+}
+
+TEST_F(FieldTest, DuplicateKeys) {
+    // A repeated key must not be reported as unknown, and its field must get the same value as a
+    // lookup in the map would.
+    pn::string_view text = "b: 1\nd: 2\nd: 3\ninner: {x: 5}\n";
+    pn::value       x    = parse(text);
+    Outer           o    = read_outer(text);
+    EXPECT_THAT(o.b, Eq(1));
+    ASSERT_THAT(o.d.has_value(), Eq(true));
+    EXPECT_THAT(*o.d, Eq(x.as_map().get("d").as_int()));
+}
+
+}  // namespace
+}  // namespace antares
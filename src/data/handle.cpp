@@ -0,0 +1,44 @@
+// Copyright (C) 2018 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "data/handle.hpp"
+
+#include <deque>
+#include <map>
+
+#include "lang/defines.hpp"
+
+namespace antares {
+
+int intern(pn::string_view name) {
+    // Function-local, because NamedHandle constants are constructed during static
+    // initialization.  Names are owned by `names`, which never moves its elements, so `ids` can
+    // key on views into it.
+    static ANTARES_GLOBAL std::deque<pn::string> names;
+    static ANTARES_GLOBAL std::map<pn::string_view, int> ids;
+
+    auto it = ids.find(name);
+    if (it != ids.end()) {
+        return it->second;
+    }
+    names.emplace_back(name.copy());
+    int id = ids.size();
+    ids.emplace(names.back(), id);
+    return id;
+}
+
+}  // namespace antares
@@ -22,7 +22,7 @@
 
 namespace antares {
 
-FIELD_READER(BuildableObject) { return BuildableObject{read_field<pn::string>(x)}; }
+FIELD_READER(BuildableObject) { return BuildableObject(read_field<pn::string>(x)); }
 
 FIELD_READER(std::vector<BuildableObject>) {
     std::vector<BuildableObject> objects =
@@ -68,10 +68,12 @@ const Level* Level::get(int number) { return Level::get(plug.chapters[number]);
 const Level* Level::get(pn::string_view name) {
     auto it = plug.levels.find(name.copy());
     if (it == plug.levels.end()) {
-        return nullptr;
-    } else {
-        return &it->second;
+        if (plug.level_names.find(name.copy()) == plug.level_names.end()) {
+            return nullptr;
+        }
+        it = plug.levels.emplace(name.copy(), Resource::level(name)).first;
     }
+    return &it->second;
 }
 
 FIELD_READER(LevelBase::PlayerType) {
@@ -184,4 +186,9 @@ Level level(pn::value_cref x0) {
     }
 }
 
+sfz::optional<int64_t> level_chapter(pn::value_cref x0) {
+    path_value x{x0};
+    return read_field<sfz::optional<int64_t>>(x.get("chapter"));
+}
+
 }  // namespace antares
@@ -49,13 +49,17 @@ static constexpr const char kStarmapPicture[] = "starmap";
 
 ANTARES_GLOBAL ScenarioGlobals plug;
 
+// Catalogs the levels in the plugin, and which chapter each is.  Levels are otherwise read only
+// when they are first used, by Level::get().
 static void read_all_levels() {
+    plug.level_names.clear();
     plug.levels.clear();
     plug.chapters.clear();
     for (pn::string_view name : Resource::list_levels()) {
-        auto it = plug.levels.emplace(name.copy(), Resource::level(name)).first;
-        if (it->second.base.chapter.has_value()) {
-            auto chapter = *it->second.base.chapter;
+        plug.level_names.insert(name.copy());
+        auto chapter_number = Resource::level_chapter(name);
+        if (chapter_number.has_value()) {
+            auto chapter = *chapter_number;
             if (plug.chapters.find(chapter) != plug.chapters.end()) {
                 throw std::runtime_error(pn::format(
                                                  "duplicate chapter {} in levels {} and {}",
@@ -77,6 +81,8 @@ void PluginInit(sfz::optional<pn::string_view> path) {
             plug.zip.reset(new zipxx::ZipArchive(*path, 0));
         }
     }
+    Resource::build_index();
+    plug.tag_numbers.clear();
 
     plug.info = Resource::info();
     try {
@@ -101,10 +107,14 @@ void load_race(const NamedHandle<const Race>& r) {
 }
 
 void load_object(const NamedHandle<const BaseObject>& o) {
-    if (plug.objects.find(o.name().copy()) != plug.objects.end()) {
+    if ((o.id() < plug.object_ids.size()) && plug.object_ids[o.id()]) {
         return;  // already loaded.
     }
-    plug.objects.emplace(o.name().copy(), Resource::object(o.name()));
+    auto it = plug.objects.emplace(o.name().copy(), Resource::object(o.name())).first;
+    if (o.id() >= plug.object_ids.size()) {
+        plug.object_ids.resize(o.id() + 1, nullptr);
+    }
+    plug.object_ids[o.id()] = &it->second;
 }
 
 }  // namespace antares
@@ -18,11 +18,18 @@
 
 #include "data/resource.hpp"
 
+#include <ctype.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
+#include <algorithm>
 #include <array>
+#include <deque>
+#include <memory>
 #include <pn/input>
 #include <sfz/sfz.hpp>
+#include <unordered_set>
 #include <zipxx/zipxx.hpp>
 
 #include "config/dirs.hpp"
@@ -43,6 +50,7 @@
 #include "data/sprite-data.hpp"
 #include "drawing/text.hpp"
 #include "game/sys.hpp"
+#include "lang/defines.hpp"
 #include "video/driver.hpp"
 
 namespace path = sfz::path;
@@ -82,6 +90,116 @@ class ResourceLister : public sfz::TreeWalker {
     std::vector<pn::string>* const _names;
 };
 
+// isfile() on the default macOS and Windows filesystems ignores case, so an index of files in a
+// directory must too.  Only ASCII is folded, which covers every resource name the game asks for.
+// Zip entries are matched exactly, as ZipArchive::locate() does, on every platform.
+#if defined(__APPLE__) || defined(_WIN32)
+static const bool kFilesIgnoreCase = true;
+#else
+static const bool kFilesIgnoreCase = false;
+#endif
+
+// The top-level directories whose files resource_exists() is asked about.  Only these are indexed;
+// anything else in a data directory (scenarios, downloads, the registry) is skipped.
+static const pn::string_view kIndexedDirs[] = {"fonts", "music", "objects", "pictures", "sounds"};
+
+static bool is_indexed(pn::string_view path) {
+    for (pn::string_view dir : kIndexedDirs) {
+        if ((path.size() > dir.size()) && (path.substr(0, dir.size()) == dir) &&
+            (path.data()[dir.size()] == '/')) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// A set of resource paths, hashed so that a lookup doesn't allocate or compare against more than
+// a few other paths.  Paths of files in directories compare as path::isfile() would; paths of
+// entries in zip archives compare exactly.
+class ResourceIndex {
+  public:
+    void insert_file(pn::string_view path) { insert(&_files, path); }
+    void insert_zip_entry(pn::string_view path) { insert(&_zip_entries, path); }
+
+    bool contains(pn::string_view path) const {
+        return (_zip_entries.find(path) != _zip_entries.end()) ||
+               (_files.find(path) != _files.end());
+    }
+
+  private:
+    static uint8_t fold(bool ignore_case, char ch) {
+        return (ignore_case && ('A' <= ch) && (ch <= 'Z')) ? (ch - 'A' + 'a') : ch;
+    }
+
+    struct Hash {
+        bool   ignore_case;
+        size_t operator()(pn::string_view s) const {
+            // FNV-1a
+            uint64_t h = 0xcbf29ce484222325ULL;
+            for (int i = 0; i < s.size(); ++i) {
+                h = (h ^ fold(ignore_case, s.data()[i])) * 0x100000001b3ULL;
+            }
+            return h;
+        }
+    };
+
+    struct Equal {
+        bool ignore_case;
+        bool operator()(pn::string_view a, pn::string_view b) const {
+            if (a.size() != b.size()) {
+                return false;
+            }
+            for (int i = 0; i < a.size(); ++i) {
+                if (fold(ignore_case, a.data()[i]) != fold(ignore_case, b.data()[i])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    typedef std::unordered_set<pn::string_view, Hash, Equal> Set;
+
+    void insert(Set* set, pn::string_view path) {
+        if (is_indexed(path) && (set->find(path) == set->end())) {
+            _storage.push_back(path.copy());
+            set->insert(_storage.back());
+        }
+    }
+
+    std::deque<pn::string> _storage;  // doesn't move what the sets point to.
+    Set                    _files{0, Hash{kFilesIgnoreCase}, Equal{kFilesIgnoreCase}};
+    Set                    _zip_entries{0, Hash{false}, Equal{false}};
+};
+
+// Indexes every regular file under `root`.  Walk it logically, so that a file reached through a
+// symlink, or that is one, is indexed, just as path::isfile() would find it.
+class ResourceIndexer : public sfz::TreeWalker {
+  public:
+    ResourceIndexer(pn::string_view root, ResourceIndex* paths)
+            : _root_size(root.size()), _paths(paths) {}
+
+    void file(pn::string_view name, const sfz::Stat& st) const override {
+        _paths->insert_file(name.substr(_root_size + 1));
+    }
+
+    void pre_directory(pn::string_view name, const sfz::Stat& st) const override {}
+    void cycle_directory(pn::string_view name, const sfz::Stat& st) const override {}
+    void post_directory(pn::string_view name, const sfz::Stat& st) const override {}
+    void symlink(pn::string_view name, const sfz::Stat& st) const override {}
+    void broken_symlink(pn::string_view name, const sfz::Stat& st) const override {}
+    void other(pn::string_view name, const sfz::Stat& st) const override {}
+
+  private:
+    const int            _root_size;
+    ResourceIndex* const _paths;
+};
+
+// Every indexed resource path in the plugin and the fallback data directories, or null if
+// Resource::build_index() hasn't been called yet.  It is built by PluginInit() and replaced by the
+// next one; files added to or removed from the data directories in between aren't noticed.
+ANTARES_GLOBAL std::unique_ptr<ResourceIndex> resource_paths;
+
 class TextResourceData {
   public:
     static TextResourceData load(pn::string_view resource_path) {
@@ -166,14 +284,8 @@ class BinaryResourceData {
                         .c_str());
     }
 
-    pn::data data() {
-        pn::data d;
-        if (_input.read(pn::all(d)).error()) {
-            throw std::runtime_error("read error");
-        }
-        return d;
-    }
-
+    // Valid for as long as this object is; files are mapped rather than read.
+    pn::data_view  data() const { return _data; }
     pn::input_view input() const { return _input; }
 
   private:
@@ -182,7 +294,9 @@ class BinaryResourceData {
         if (!path::isfile(path)) {
             return false;
         }
-        _input = pn::input{path, pn::binary};
+        _file.reset(new sfz::mapped_file(path));
+        _data  = _file->data();
+        _input = _data.input();
         return true;
     }
 
@@ -192,11 +306,14 @@ class BinaryResourceData {
             return false;
         }
         _zip_file.reset(new zipxx::ZipFileReader(zip, index));
-        _input = _zip_file->data().input();
+        _data  = _zip_file->data();
+        _input = _data.input();
         return true;
     }
 
+    std::unique_ptr<sfz::mapped_file>     _file;
     std::unique_ptr<zipxx::ZipFileReader> _zip_file;
+    pn::data_view                         _data;
     pn::input                             _input;
 };
 
@@ -209,6 +326,9 @@ static bool resource_exists_in_zip(const zipxx::ZipArchive& zip, pn::string_view
 }
 
 static bool resource_exists(pn::string_view resource_path) {
+    if (resource_paths && is_indexed(resource_path)) {
+        return resource_paths->contains(resource_path);
+    }
     return (plug.dir.has_value() && resource_exists_in_dir(*plug.dir, resource_path)) ||
            (plug.zip && resource_exists_in_zip(*plug.zip, resource_path)) ||
            resource_exists_in_dir(factory_scenario_path(), resource_path) ||
@@ -251,6 +371,29 @@ static std::vector<pn::string> list_resources(pn::string_view dir, pn::string_vi
     return resources;
 }
 
+static void index_dir(pn::string_view root, ResourceIndex* paths) {
+    for (pn::string_view dir : kIndexedDirs) {
+        pn::string path = pn::format("{0}/{1}", root, dir);
+        if (path::isdir(path)) {
+            sfz::walk(path, sfz::WALK_LOGICAL, ResourceIndexer(root, paths));
+        }
+    }
+}
+
+void Resource::build_index() {
+    std::unique_ptr<ResourceIndex> paths(new ResourceIndex);
+    if (plug.dir.has_value()) {
+        index_dir(*plug.dir, paths.get());
+    } else if (plug.zip) {
+        for (auto i : sfz::range(plug.zip->size())) {
+            paths->insert_zip_entry(pn::string_view{plug.zip->name(i)});
+        }
+    }
+    index_dir(factory_scenario_path(), paths.get());
+    index_dir(application_path(), paths.get());
+    resource_paths = std::move(paths);
+}
+
 std::vector<pn::string> Resource::list_levels() { return list_resources("levels", ".pn"); }
 std::vector<pn::string> Resource::list_replays() { return list_resources("replays", ".NLRP"); }
 
@@ -362,6 +505,75 @@ Level Resource::level(pn::string_view name) {
     }
 }
 
+// Finds the value of a level's top-level `chapter` key without parsing the file.  Level files are
+// written as block maps, in which top-level keys are the only lines that start in column 0,
+// apart from comments.  Returns false if `text` isn't in that form, or if `chapter` isn't a plain
+// decimal int or null, and leaves it to the parser to read it or report the error.
+static bool scan_chapter(pn::string_view text, sfz::optional<int64_t>* chapter) {
+    static const char kKey[]  = "chapter:";
+    const size_t      key_len = strlen(kKey);
+    const char* const end     = text.data() + text.size();
+    bool              first   = true;
+    for (const char* line = text.data(); line < end;) {
+        const char* eol  = std::find(line, end, '\n');
+        const char* next = (eol == end) ? end : (eol + 1);
+        if ((line == eol) || (*line == ' ') || (*line == '\t') || (*line == '\r') ||
+            (*line == '#')) {
+            line = next;
+            continue;
+        }
+        if (first && !isalpha(*line) && (*line != '_')) {
+            return false;  // not a block map.
+        }
+        first = false;
+        if ((static_cast<size_t>(eol - line) < key_len) || (strncmp(line, kKey, key_len) != 0)) {
+            line = next;
+            continue;
+        }
+
+        const char* p = line + key_len;
+        while ((p < eol) && ((*p == ' ') || (*p == '\t'))) {
+            ++p;
+        }
+        if (((eol - p) >= 4) && (strncmp(p, "null", 4) == 0)) {
+            chapter->reset();
+            p += 4;
+        } else {
+            const char* value = p;
+            if ((p < eol) && (*p == '-')) {
+                ++p;
+            }
+            const char* digits = p;
+            while ((p < eol) && isdigit(*p)) {
+                ++p;
+            }
+            if ((p == digits) || ((p - digits) > 18)) {
+                return false;
+            }
+            chapter->emplace(strtoll(value, nullptr, 10));
+        }
+        while ((p < eol) && ((*p == ' ') || (*p == '\t') || (*p == '\r'))) {
+            ++p;
+        }
+        return (p == eol) || (*p == '#');
+    }
+    chapter->reset();
+    return true;
+}
+
+sfz::optional<int64_t> Resource::level_chapter(pn::string_view name) {
+    pn::string path = pn::format("levels/{0}.pn", name);
+    try {
+        sfz::optional<int64_t> chapter;
+        if (scan_chapter(TextResourceData::load(path).string(), &chapter)) {
+            return chapter;
+        }
+        return ::antares::level_chapter(procyon(path));
+    } catch (...) {
+        std::throw_with_nested(std::runtime_error(path.c_str()));
+    }
+}
+
 SoundData Resource::music(pn::string_view name) {
     return load_audio(pn::format("music/{0}", name));
 }
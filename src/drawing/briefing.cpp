@@ -38,9 +38,67 @@ namespace antares {
 
 const int32_t kBriefing_Grid_Size = 16;
 
+namespace {
+
+// Which cells of the briefing starmap already have a sprite on them.  Alongside the cells it
+// keeps a summed-area table, so testing whether a rect is free takes the same time for any size
+// of sprite.
+class BriefingGrid {
+  public:
+    BriefingGrid(int32_t width, int32_t height)
+            : _width(width),
+              _height(height),
+              _cells(width * height, false),
+              _sums((width + 1) * (height + 1), 0) {}
+
+    int32_t width() const { return _width; }
+    int32_t height() const { return _height; }
+
+    // True if no cell in `cells` is in use.  Bounds are inclusive and must lie within the grid.
+    bool is_free(const Rect& cells) const {
+        if ((cells.right < cells.left) || (cells.bottom < cells.top)) {
+            return true;
+        }
+        return (sum(cells.right + 1, cells.bottom + 1) - sum(cells.left, cells.bottom + 1) -
+                sum(cells.right + 1, cells.top) + sum(cells.left, cells.top)) == 0;
+    }
+
+    // Marks every cell in `cells` as in use.  Bounds are as for is_free().
+    void fill(const Rect& cells) {
+        if ((cells.right < cells.left) || (cells.bottom < cells.top)) {
+            return;
+        }
+        for (int32_t y = cells.top; y <= cells.bottom; ++y) {
+            for (int32_t x = cells.left; x <= cells.right; ++x) {
+                _cells[(y * _width) + x] = true;
+            }
+        }
+
+        // Rows above `cells` are unaffected; recompute the sums from there down.
+        for (int32_t y = cells.top; y < _height; ++y) {
+            int32_t row = 0;
+            for (int32_t x = 0; x < _width; ++x) {
+                row += _cells[(y * _width) + x];
+                _sums[((y + 1) * (_width + 1)) + x + 1] = _sums[(y * (_width + 1)) + x + 1] + row;
+            }
+        }
+    }
+
+  private:
+    // Number of cells in use with x < `x` and y < `y`.
+    int32_t sum(int32_t x, int32_t y) const { return _sums[(y * (_width + 1)) + x]; }
+
+    const int32_t        _width;
+    const int32_t        _height;
+    std::vector<bool>    _cells;
+    std::vector<int32_t> _sums;
+};
+
+}  // namespace
+
 static Point BriefingSprite_GetBestLocation(
-        const NatePixTable::Frame& frame, Scale scale, Point fromWhere, bool* grid,
-        int32_t gridWidth, int32_t gridHeight, const Rect& bounds);
+        const NatePixTable::Frame& frame, Scale scale, Point fromWhere, const BriefingGrid& grid,
+        const Rect& bounds);
 
 static void GetInitialObjectSpriteData(
         Handle<const Initial> whichObject, int32_t maxSize, const Rect& bounds,
@@ -54,61 +112,50 @@ static void GetRealObjectSpriteData(
         const NatePixTable::Frame** frame, Point* where);
 
 static bool BriefingSprite_IsLocationLegal(
-        const NatePixTable::Frame& frame, Scale scale, Point where, bool* grid, int32_t gridWidth,
-        int32_t gridHeight, const Rect& bounds);
+        const NatePixTable::Frame& frame, Scale scale, Point where, const BriefingGrid& grid,
+        const Rect& bounds);
 
 static void BriefingSprite_UseLocation(
-        const NatePixTable::Frame& frame, Scale scale, Point where, bool* grid, int32_t gridWidth,
-        int32_t gridHeight, const Rect& bounds);
-
-static bool Briefing_Grid_Get(
-        bool* grid, int32_t x, int32_t y, int32_t gridWidth, int32_t gridHeight);
-
-static void Briefing_Grid_Set(
-        bool* grid, int32_t x, int32_t y, int32_t gridWidth, int32_t gridHeight, bool value);
+        const NatePixTable::Frame& frame, Scale scale, Point where, BriefingGrid* grid,
+        const Rect& bounds);
 
 static Point BriefingSprite_GetBestLocation(
-        const NatePixTable::Frame& frame, Scale scale, Point fromWhere, bool* grid,
-        int32_t gridWidth, int32_t gridHeight, const Rect& bounds) {
+        const NatePixTable::Frame& frame, Scale scale, Point fromWhere, const BriefingGrid& grid,
+        const Rect& bounds) {
     int32_t offsetSize = 1, i;
     Point   result     = fromWhere;
 
-    if (BriefingSprite_IsLocationLegal(
-                frame, scale, result, grid, gridWidth, gridHeight, bounds)) {
+    if (BriefingSprite_IsLocationLegal(frame, scale, result, grid, bounds)) {
         return result;
     }
 
-    while (offsetSize < gridWidth) {
+    while (offsetSize < grid.width()) {
         for (i = -offsetSize; i <= offsetSize; i++) {
             // try left
             result.h = fromWhere.h - (offsetSize * kBriefing_Grid_Size);
             result.v = fromWhere.v + (i * kBriefing_Grid_Size);
-            if (BriefingSprite_IsLocationLegal(
-                        frame, scale, result, grid, gridWidth, gridHeight, bounds)) {
+            if (BriefingSprite_IsLocationLegal(frame, scale, result, grid, bounds)) {
                 return result;
             }
 
             // try right
             result.h = fromWhere.h + (offsetSize * kBriefing_Grid_Size);
             result.v = fromWhere.v + (i * kBriefing_Grid_Size);
-            if (BriefingSprite_IsLocationLegal(
-                        frame, scale, result, grid, gridWidth, gridHeight, bounds)) {
+            if (BriefingSprite_IsLocationLegal(frame, scale, result, grid, bounds)) {
                 return result;
             }
 
             // try top
             result.h = fromWhere.h + (i * kBriefing_Grid_Size);
             result.v = fromWhere.v - (offsetSize * kBriefing_Grid_Size);
-            if (BriefingSprite_IsLocationLegal(
-                        frame, scale, result, grid, gridWidth, gridHeight, bounds)) {
+            if (BriefingSprite_IsLocationLegal(frame, scale, result, grid, bounds)) {
                 return result;
             }
 
             // try bottom
             result.h = fromWhere.h + (i * kBriefing_Grid_Size);
             result.v = fromWhere.v + (offsetSize * kBriefing_Grid_Size);
-            if (BriefingSprite_IsLocationLegal(
-                        frame, scale, result, grid, gridWidth, gridHeight, bounds)) {
+            if (BriefingSprite_IsLocationLegal(frame, scale, result, grid, bounds)) {
                 return result;
             }
         }
@@ -118,96 +165,38 @@ static Point BriefingSprite_GetBestLocation(
     return result;
 }
 
-static bool BriefingSprite_IsLocationLegal(
-        const NatePixTable::Frame& frame, Scale scale, Point where, bool* grid, int32_t gridWidth,
-        int32_t gridHeight, const Rect& bounds) {
-    Rect    spriteBounds;
-    int32_t i, j;
-
-    spriteBounds = scale_sprite_rect(frame, where, scale);
-    spriteBounds.offset(-bounds.left, -bounds.top);
-    spriteBounds.left /= kBriefing_Grid_Size;
-    spriteBounds.right /= kBriefing_Grid_Size;
-    spriteBounds.top /= kBriefing_Grid_Size;
-    spriteBounds.bottom /= kBriefing_Grid_Size;
-    if (spriteBounds.left < 1)
-        return false;
-    if (spriteBounds.right >= gridWidth)
-        return false;
-    if (spriteBounds.top < 1)
-        return false;
-    if (spriteBounds.bottom >= gridHeight)
-        return false;
-
-    for (j = spriteBounds.top; j <= spriteBounds.bottom; j++) {
-        for (i = spriteBounds.left; i <= spriteBounds.right; i++) {
-            if (Briefing_Grid_Get(grid, i, j, gridWidth, gridHeight))
-                return false;
-        }
-    }
-    return true;
-}
-
-static void BriefingSprite_UseLocation(
-        const NatePixTable::Frame& frame, Scale scale, Point where, bool* grid, int32_t gridWidth,
-        int32_t gridHeight, const Rect& bounds) {
-    Rect    spriteBounds;
-    int32_t i, j;
-
-    spriteBounds = scale_sprite_rect(frame, where, scale);
+// Returns the grid cells under the sprite, or nothing if they would include the first row or
+// column, or run off the end of the grid.
+static sfz::optional<Rect> BriefingSprite_Cells(
+        const NatePixTable::Frame& frame, Scale scale, Point where, const BriefingGrid& grid,
+        const Rect& bounds) {
+    Rect spriteBounds = scale_sprite_rect(frame, where, scale);
     spriteBounds.offset(-bounds.left, -bounds.top);
     spriteBounds.left /= kBriefing_Grid_Size;
     spriteBounds.right /= kBriefing_Grid_Size;
     spriteBounds.top /= kBriefing_Grid_Size;
     spriteBounds.bottom /= kBriefing_Grid_Size;
-    if (spriteBounds.left < 1)
-        return;
-    if (spriteBounds.right >= gridWidth)
-        return;
-    if (spriteBounds.top < 1)
-        return;
-    if (spriteBounds.bottom >= gridHeight)
-        return;
-
-    for (j = spriteBounds.top; j <= spriteBounds.bottom; j++) {
-        for (i = spriteBounds.left; i <= spriteBounds.right; i++) {
-            Briefing_Grid_Set(grid, i, j, gridWidth, gridHeight, true);
-        }
+    if ((spriteBounds.left < 1) || (spriteBounds.right >= grid.width()) ||
+        (spriteBounds.top < 1) || (spriteBounds.bottom >= grid.height())) {
+        return sfz::nullopt;
     }
+    return sfz::make_optional(spriteBounds);
 }
 
-static bool Briefing_Grid_Get(
-        bool* grid, int32_t x, int32_t y, int32_t gridWidth, int32_t gridHeight) {
-    if (grid == NULL)
-        return true;
-    if (x < 1)
-        return true;
-    if (x >= gridWidth)
-        return true;
-    if (y < 1)
-        return true;
-    if (y >= gridHeight)
-        return true;
-
-    grid = grid + (y * gridWidth) + x;
-    return *grid;
+static bool BriefingSprite_IsLocationLegal(
+        const NatePixTable::Frame& frame, Scale scale, Point where, const BriefingGrid& grid,
+        const Rect& bounds) {
+    auto cells = BriefingSprite_Cells(frame, scale, where, grid, bounds);
+    return cells.has_value() && grid.is_free(*cells);
 }
 
-static void Briefing_Grid_Set(
-        bool* grid, int32_t x, int32_t y, int32_t gridWidth, int32_t gridHeight, bool value) {
-    if (grid == NULL)
-        return;
-    if (x < 1)
-        return;
-    if (x >= gridWidth)
-        return;
-    if (y < 1)
-        return;
-    if (y >= gridHeight)
-        return;
-
-    grid  = grid + (y * gridWidth) + x;
-    *grid = value;
+static void BriefingSprite_UseLocation(
+        const NatePixTable::Frame& frame, Scale scale, Point where, BriefingGrid* grid,
+        const Rect& bounds) {
+    auto cells = BriefingSprite_Cells(frame, scale, where, *grid, bounds);
+    if (cells.has_value()) {
+        grid->fill(*cells);
+    }
 }
 
 static void GetInitialObjectSpriteData(
@@ -249,21 +238,10 @@ std::vector<sfz::optional<BriefingSprite>> render_briefing(
         int32_t maxSize, const Rect& bounds, const Point& corner, Scale scale) {
     std::vector<sfz::optional<BriefingSprite>> result;
     Scale                                      thisScale;
-    int32_t                                    gridWidth, gridHeight, i, j;
     Point                                      where;
 
-    gridWidth  = (bounds.right - bounds.left) / kBriefing_Grid_Size;
-    gridHeight = (bounds.bottom - bounds.top) / kBriefing_Grid_Size;
-
-    std::unique_ptr<bool[]> gridCells(new bool[gridWidth * gridHeight]);
-    if (gridCells == nullptr) {
-        return result;
-    }
-    for (j = 0; j < gridHeight; j++) {
-        for (i = 0; i < gridWidth; i++) {
-            Briefing_Grid_Set(gridCells.get(), i, j, gridWidth, gridHeight, false);
-        }
-    }
+    BriefingGrid grid{(bounds.right - bounds.left) / kBriefing_Grid_Size,
+                      (bounds.bottom - bounds.top) / kBriefing_Grid_Size};
 
     result.resize(kMaxSpaceObject);
 
@@ -280,11 +258,9 @@ std::vector<sfz::optional<BriefingSprite>> render_briefing(
                     corner, scale, &thisScale, &frame, &where);
             thisScale = scale_by(kOneQuarterScale, sprite_scale(*baseObject));
 
-            where = BriefingSprite_GetBestLocation(
-                    *frame, thisScale, where, gridCells.get(), gridWidth, gridHeight, bounds);
+            where = BriefingSprite_GetBestLocation(*frame, thisScale, where, grid, bounds);
 
-            BriefingSprite_UseLocation(
-                    *frame, thisScale, where, gridCells.get(), gridWidth, gridHeight, bounds);
+            BriefingSprite_UseLocation(*frame, thisScale, where, &grid, bounds);
 
             result[anObject.number()].emplace(
                     BriefingSprite{*frame, scale_sprite_rect(*frame, where, thisScale), false});
@@ -295,10 +271,8 @@ std::vector<sfz::optional<BriefingSprite>> render_briefing(
                     corner, scale, &thisScale, &frame, &where);
             thisScale = scale_by(kOneQuarterScale, sprite_scale(*baseObject));
 
-            where = BriefingSprite_GetBestLocation(
-                    *frame, thisScale, where, gridCells.get(), gridWidth, gridHeight, bounds);
-            BriefingSprite_UseLocation(
-                    *frame, thisScale, where, gridCells.get(), gridWidth, gridHeight, bounds);
+            where = BriefingSprite_GetBestLocation(*frame, thisScale, where, grid, bounds);
+            BriefingSprite_UseLocation(*frame, thisScale, where, &grid, bounds);
 
             Hue hue = Hue::BLUE;
             if (anObject->owner.number() >= 0) {
@@ -40,13 +40,19 @@ const Font& interface_font(InterfaceStyle style) {
     }
 }
 
-void draw_text_in_rect(Rect tRect, pn::string_view text, InterfaceStyle style, Hue hue) {
-    const StyledText interface_text = StyledText::interface(
-            text,
-            {interface_font(style), tRect.width(), kInterfaceTextHBuffer, kInterfaceTextVBuffer},
+StyledText interface_text(pn::string_view text, InterfaceStyle style, Hue hue, int32_t width) {
+    return StyledText::interface(
+            text, {interface_font(style), width, kInterfaceTextHBuffer, kInterfaceTextVBuffer},
             GetRGBTranslateColorShade(hue, LIGHTEST));
+}
+
+void draw_text_in_rect(Rect tRect, const StyledText& text) {
     tRect.offset(0, -kInterfaceTextVBuffer);
-    interface_text.draw(tRect);
+    text.draw(tRect);
+}
+
+void draw_text_in_rect(Rect tRect, pn::string_view text, InterfaceStyle style, Hue hue) {
+    draw_text_in_rect(tRect, interface_text(text, style, hue, tRect.width()));
 }
 
 int16_t GetInterfaceTextHeightFromWidth(
@@ -19,6 +19,7 @@
 #include "drawing/sprite-handling.hpp"
 
 #include <numeric>
+#include <vector>
 #include <sfz/sfz.hpp>
 
 #include "data/resource.hpp"
@@ -165,43 +166,78 @@ Rect scale_sprite_rect(const NatePixTable::Frame& frame, Point where, Scale scal
     };
 }
 
-void draw_sprites() {
-    if (gAbsoluteScale >= kBlipThreshhold) {
-        for (BaseObject::Layer layer :
-             {BaseObject::Layer::BASES, BaseObject::Layer::SHIPS, BaseObject::Layer::SHOTS}) {
-            for (auto aSprite : Sprite::all()) {
-                if ((aSprite->table != NULL) && !aSprite->killMe &&
-                    (aSprite->whichLayer == layer)) {
-                    Scale trueScale                  = scale_by(aSprite->scale, gAbsoluteScale);
-                    const NatePixTable::Frame& frame = aSprite->table->at(aSprite->whichShape);
+// Live sprites in each of the three drawn layers, in slot order.  Rebuilt by draw_sprites() in
+// a single pass over the sprite table; kept around so the vectors' storage is reused.
+static ANTARES_GLOBAL std::vector<Sprite*> layer_sprites[3];
+
+static void bucket_sprites() {
+    for (auto& bucket : layer_sprites) {
+        bucket.clear();
+    }
+    for (auto aSprite : Sprite::all()) {
+        if ((aSprite->table == NULL) || aSprite->killMe) {
+            continue;
+        }
+        switch (aSprite->whichLayer) {
+            case BaseObject::Layer::BASES:
+            case BaseObject::Layer::SHIPS:
+            case BaseObject::Layer::SHOTS:
+                layer_sprites[static_cast<int>(aSprite->whichLayer) - 1].push_back(
+                        aSprite.get());
+                break;
+            default: break;
+        }
+    }
+}
 
-                    Rect draw_rect = scale_sprite_rect(frame, aSprite->where, trueScale);
+void draw_sprites() {
+    bucket_sprites();
 
-                    switch (aSprite->style) {
-                        case spriteNormal: frame.texture().draw(draw_rect); break;
+    // Nothing is visible beyond the edge of the screen; skip sprites that lie wholly outside it.
+    const Rect screen = world();
 
-                        case spriteColor:
-                            Randomize(63);
+    if (gAbsoluteScale >= kBlipThreshhold) {
+        for (const auto& bucket : layer_sprites) {
+            for (Sprite* aSprite : bucket) {
+                Scale trueScale                  = scale_by(aSprite->scale, gAbsoluteScale);
+                const NatePixTable::Frame& frame = aSprite->table->at(aSprite->whichShape);
+
+                Rect draw_rect = scale_sprite_rect(frame, aSprite->where, trueScale);
+
+                switch (aSprite->style) {
+                    case spriteNormal:
+                        if (draw_rect.intersects(screen)) {
+                            frame.texture().draw(draw_rect);
+                        }
+                        break;
+
+                    case spriteColor:
+                        // Advance the static noise whether or not it's drawn, so on-screen
+                        // sprites don't change their pattern depending on what's off-screen.
+                        Randomize(63);
+                        if (draw_rect.intersects(screen)) {
                             frame.texture().draw_static(
                                     draw_rect, aSprite->styleColor, aSprite->styleData);
-                            break;
-                    }
+                        }
+                        break;
                 }
             }
         }
     } else {
-        for (BaseObject::Layer layer :
-             {BaseObject::Layer::BASES, BaseObject::Layer::SHIPS, BaseObject::Layer::SHOTS}) {
-            for (auto aSprite : Sprite::all()) {
+        for (const auto& bucket : layer_sprites) {
+            for (Sprite* aSprite : bucket) {
                 int tinySize = aSprite->icon.size;
-                if ((aSprite->table != NULL) && !aSprite->killMe && tinySize &&
-                    (aSprite->draw_tiny != NULL) && (aSprite->whichLayer == layer)) {
-                    Rect tiny_rect(-tinySize, -tinySize, tinySize, tinySize);
-                    tiny_rect.offset(aSprite->where.h, aSprite->where.v);
-                    aSprite->draw_tiny(
-                            tiny_rect, GetRGBTranslateColorShade(
-                                               aSprite->tinyColor.hue, aSprite->tinyColor.shade));
+                if (!tinySize || (aSprite->draw_tiny == NULL)) {
+                    continue;
+                }
+                Rect tiny_rect(-tinySize, -tinySize, tinySize, tinySize);
+                tiny_rect.offset(aSprite->where.h, aSprite->where.v);
+                if (!tiny_rect.intersects(screen)) {
+                    continue;
                 }
+                aSprite->draw_tiny(
+                        tiny_rect, GetRGBTranslateColorShade(
+                                           aSprite->tinyColor.hue, aSprite->tinyColor.shade));
             }
         }
     }
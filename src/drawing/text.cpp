@@ -55,7 +55,17 @@ Font::Font(
           logicalWidth(logical_width),
           height(height),
           ascent(ascent),
-          _glyphs(glyphs) {}
+          _glyphs(glyphs) {
+    for (uint32_t i = 0; i < _ascii_glyphs.size(); ++i) {
+        auto it = _glyphs.find(pn::rune{i});
+        if (it == _glyphs.end()) {
+            it = _glyphs.find(pn::rune{'?'});
+        }
+        if (it != _glyphs.end()) {
+            _ascii_glyphs[i] = it->second;
+        }
+    }
+}
 
 Font font(pn::string_view name) {
     FontData d       = Resource::font(name);
@@ -66,6 +76,9 @@ Font font(pn::string_view name) {
 Font::~Font() {}
 
 Rect Font::glyph_rect(pn::rune rune) const {
+    if (rune.value() < _ascii_glyphs.size()) {
+        return _ascii_glyphs[rune.value()];
+    }
     auto it = _glyphs.find(rune);
     if (it == _glyphs.end()) {
         return glyph_rect(pn::rune{'?'});
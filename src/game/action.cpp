@@ -745,6 +745,13 @@ static ActionCursor apply(
             return ActionCursor{};
 
         case Action::Type::GROUP:
+            if (next.begin == next.end) {
+                // Nothing is left at this level to come back to, so continue straight to its
+                // continuation (if any), rather than allocating a frame for an empty cursor.
+                ActionCursor group{a.group.of, subject, direct, offset};
+                group.continuation = std::move(next.continuation);
+                return group;
+            }
             return ActionCursor{a.group.of, subject, direct, offset, std::move(next)};
 
         case Action::Type::AGE: apply(a.age, subject, direct, offset); break;
@@ -169,7 +169,7 @@ Handle<Destination> MakeNewDestination(
     d->totalBuildTime = d->buildTime = ticks(0);
     d->canBuildType.clear();
     for (const BuildableObject& o : canBuildType) {
-        d->canBuildType.emplace_back(BuildableObject{o.name.copy()});
+        d->canBuildType.emplace_back(o.copy());
     }
 
     if (name.has_value()) {
@@ -247,7 +247,7 @@ void RecalcAllAdmiralBuildData() {
         for (const BuildableObject& buildable_class : d->canBuildType) {
             bool found = false;
             for (const admiralBuildType& admiral_build : a->canBuildType()) {
-                if (admiral_build.buildable.name == buildable_class.name) {
+                if (admiral_build.buildable.id == buildable_class.id) {
                     found = true;
                     break;
                 }
@@ -258,7 +258,7 @@ void RecalcAllAdmiralBuildData() {
             auto baseObject = get_buildable_object(buildable_class, a->race());
             if (baseObject) {
                 a->canBuildType().emplace_back();
-                a->canBuildType().back().buildable = BuildableObject{buildable_class.name.copy()};
+                a->canBuildType().back().buildable = buildable_class.copy();
                 a->canBuildType().back().base      = baseObject;
                 a->canBuildType().back().chanceRange = a->totalBuildChance();
                 a->totalBuildChance() += baseObject->ai.build.ratio;
@@ -979,7 +979,7 @@ void Admiral::think_build() {
                 if ((_canBuildType[j].chanceRange <= thisValue) &&
                     (_canBuildType[j].chanceRange > friendValue)) {
                     friendValue = _canBuildType[j].chanceRange;
-                    _hopeToBuild.emplace(BuildableObject{_canBuildType[j].buildable.name.copy()});
+                    _hopeToBuild.emplace(_canBuildType[j].buildable.copy());
                 }
             }
             if (_hopeToBuild.has_value()) {
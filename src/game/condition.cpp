@@ -222,6 +222,9 @@ static bool is_true(const ConditionWhen& c) {
     }
 }
 
+// Every enabled condition is evaluated on every check; results aren't cached.  The costly
+// conditions are the ones on objects, whose state changes nearly every tick with no single point
+// of mutation to invalidate from, and the rest are integer compares no dearer than a cache check.
 void CheckLevelConditions() {
     for (auto& c : g.level->base.conditions) {
         int index = (&c - g.level->base.conditions.data());
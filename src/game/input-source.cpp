@@ -18,6 +18,7 @@
 
 #include "game/input-source.hpp"
 
+#include <algorithm>
 #include <sfz/sfz.hpp>
 
 #include "config/keys.hpp"
@@ -26,71 +27,158 @@
 #include "game/globals.hpp"
 #include "game/time.hpp"
 
-using sfz::range;
-using std::make_pair;
-
 namespace antares {
 
+class InputQueue::Pusher : public EventReceiver {
+  public:
+    explicit Pusher(Entry* entry) : _entry(entry) {}
+
+    virtual void key_down(const KeyDownEvent& event) { key(Entry::KEY_DOWN, event); }
+    virtual void key_up(const KeyUpEvent& event) { key(Entry::KEY_UP, event); }
+
+    virtual void gamepad_button_down(const GamepadButtonDownEvent& event) {
+        gamepad_button(Entry::GAMEPAD_BUTTON_DOWN, event);
+    }
+    virtual void gamepad_button_up(const GamepadButtonUpEvent& event) {
+        gamepad_button(Entry::GAMEPAD_BUTTON_UP, event);
+    }
+
+    virtual void gamepad_stick(const GamepadStickEvent& event) {
+        _entry->type  = Entry::GAMEPAD_STICK;
+        _entry->value = static_cast<int>(event.stick);
+        _entry->x     = event.x;
+        _entry->y     = event.y;
+    }
+
+    virtual void mouse_down(const MouseDownEvent& event) {
+        mouse(Entry::MOUSE_DOWN, event.button(), event.where());
+        _entry->count = event.count();
+    }
+    virtual void mouse_up(const MouseUpEvent& event) {
+        mouse(Entry::MOUSE_UP, event.button(), event.where());
+    }
+    virtual void mouse_move(const MouseMoveEvent& event) {
+        mouse(Entry::MOUSE_MOVE, 0, event.where());
+    }
+
+  private:
+    void key(Entry::Type type, const KeyEvent& event) {
+        _entry->type  = type;
+        _entry->value = event.key().value();
+    }
+
+    void gamepad_button(Entry::Type type, const GamepadButtonEvent& event) {
+        _entry->type  = type;
+        _entry->value = static_cast<int>(event.button);
+    }
+
+    void mouse(Entry::Type type, int button, Point where) {
+        _entry->type  = type;
+        _entry->value = button;
+        _entry->where = where;
+    }
+
+    Entry* _entry;
+};
+
+void InputQueue::Entry::send(EventReceiver& receiver) const {
+    switch (type) {
+        case KEY_DOWN: receiver.key_down(KeyDownEvent(event_at, Key(value))); break;
+        case KEY_UP: receiver.key_up(KeyUpEvent(event_at, Key(value))); break;
+        case GAMEPAD_BUTTON_DOWN:
+            receiver.gamepad_button_down(
+                    GamepadButtonDownEvent(event_at, static_cast<Gamepad::Button>(value)));
+            break;
+        case GAMEPAD_BUTTON_UP:
+            receiver.gamepad_button_up(
+                    GamepadButtonUpEvent(event_at, static_cast<Gamepad::Button>(value)));
+            break;
+        case GAMEPAD_STICK:
+            receiver.gamepad_stick(
+                    GamepadStickEvent(event_at, static_cast<Gamepad::Stick>(value), x, y));
+            break;
+        case MOUSE_DOWN:
+            receiver.mouse_down(MouseDownEvent(event_at, value, count, where));
+            break;
+        case MOUSE_UP: receiver.mouse_up(MouseUpEvent(event_at, value, where)); break;
+        case MOUSE_MOVE: receiver.mouse_move(MouseMoveEvent(event_at, where)); break;
+    }
+}
+
+void InputQueue::clear() {
+    _events.clear();
+    _next = 0;
+}
+
+void InputQueue::push(int admiral, game_ticks at, const Event& event) {
+    Entry entry    = {};
+    entry.admiral  = admiral;
+    entry.at       = at;
+    entry.event_at = event.at();
+    Pusher pusher(&entry);
+    event.send(&pusher);
+    _events.push_back(entry);
+}
+
+void InputQueue::send(int admiral, game_ticks at, EventReceiver& receiver) {
+    while ((_next < _events.size()) && (_events[_next].at < at)) {
+        ++_next;
+    }
+    for (size_t i = _next; (i < _events.size()) && (_events[i].at == at); ++i) {
+        if (_events[i].admiral == admiral) {
+            _events[i].send(receiver);
+        }
+    }
+}
+
+void InputQueue::drop_before(game_ticks at) {
+    while ((_next < _events.size()) && (_events[_next].at < at)) {
+        ++_next;
+    }
+    _events.erase(_events.begin(), _events.begin() + _next);
+    _next = 0;
+}
+
 InputSource::~InputSource() {}
 
 void RealInputSource::start() { _events.clear(); }
 
 bool RealInputSource::get(Handle<Admiral> admiral, game_ticks at, EventReceiver& receiver) {
-    auto events = _events.equal_range(make_pair(admiral.number(), at));
-    for (auto it : range(events.first, events.second)) {
-        it->second->send(&receiver);
-    }
+    _events.drop_before(at);
+    _events.send(admiral.number(), at, receiver);
     return true;
 }
 
 void RealInputSource::key_down(const KeyDownEvent& event) {
-    _events.emplace(
-            make_pair(g.admiral.number(), at()),
-            std::unique_ptr<Event>(new KeyDownEvent(event.at(), event.key())));
+    _events.push(g.admiral.number(), at(), event);
 }
 
 void RealInputSource::key_up(const KeyUpEvent& event) {
-    _events.emplace(
-            make_pair(g.admiral.number(), at()),
-            std::unique_ptr<Event>(new KeyUpEvent(event.at(), event.key())));
+    _events.push(g.admiral.number(), at(), event);
 }
 
 void RealInputSource::gamepad_button_down(const GamepadButtonDownEvent& event) {
-    _events.emplace(
-            make_pair(g.admiral.number(), at()),
-            std::unique_ptr<Event>(new GamepadButtonDownEvent(event.at(), event.button)));
+    _events.push(g.admiral.number(), at(), event);
 }
 
 void RealInputSource::gamepad_button_up(const GamepadButtonUpEvent& event) {
-    _events.emplace(
-            make_pair(g.admiral.number(), at()),
-            std::unique_ptr<Event>(new GamepadButtonUpEvent(event.at(), event.button)));
+    _events.push(g.admiral.number(), at(), event);
 }
 
 void RealInputSource::gamepad_stick(const GamepadStickEvent& event) {
-    _events.emplace(
-            make_pair(g.admiral.number(), at()),
-            std::unique_ptr<Event>(
-                    new GamepadStickEvent(event.at(), event.stick, event.x, event.y)));
+    _events.push(g.admiral.number(), at(), event);
 }
 
 void RealInputSource::mouse_down(const MouseDownEvent& event) {
-    _events.emplace(
-            make_pair(g.admiral.number(), at()),
-            std::unique_ptr<Event>(
-                    new MouseDownEvent(event.at(), event.button(), event.count(), event.where())));
+    _events.push(g.admiral.number(), at(), event);
 }
 
 void RealInputSource::mouse_up(const MouseUpEvent& event) {
-    _events.emplace(
-            make_pair(g.admiral.number(), at()),
-            std::unique_ptr<Event>(new MouseUpEvent(event.at(), event.button(), event.where())));
+    _events.push(g.admiral.number(), at(), event);
 }
 
 void RealInputSource::mouse_move(const MouseMoveEvent& event) {
-    _events.emplace(
-            make_pair(g.admiral.number(), at()),
-            std::unique_ptr<Event>(new MouseMoveEvent(event.at(), event.where())));
+    _events.push(g.admiral.number(), at(), event);
 }
 
 game_ticks RealInputSource::at() {
@@ -103,17 +191,25 @@ game_ticks RealInputSource::at() {
 
 ReplayInputSource::ReplayInputSource(ReplayData* data)
         : _duration(game_ticks(ticks(data->duration * 3))), _exit(false) {
-    for (auto action : data->actions) {
-        game_ticks at = game_ticks(ticks(action.at * 3));
-        for (auto key : action.keys_down) {
-            _events.emplace(
-                    make_pair(0, at),
-                    unique_ptr<Event>(new KeyDownEvent(wall_time(), sys.prefs->key(key))));
+    // Replays are recorded in order, but the queue requires it, so don't trust the file.
+    std::vector<const ReplayData::Action*> actions;
+    size_t                                 count = 0;
+    for (const auto& action : data->actions) {
+        actions.push_back(&action);
+        count += action.keys_down.size() + action.keys_up.size();
+    }
+    std::stable_sort(
+            actions.begin(), actions.end(),
+            [](const ReplayData::Action* x, const ReplayData::Action* y) { return x->at < y->at; });
+
+    _events.reserve(count);
+    for (const ReplayData::Action* action : actions) {
+        game_ticks at = game_ticks(ticks(action->at * 3));
+        for (auto key : action->keys_down) {
+            _events.push(0, at, KeyDownEvent(wall_time(), sys.prefs->key(key)));
         }
-        for (auto key : action.keys_up) {
-            _events.emplace(
-                    make_pair(0, at),
-                    unique_ptr<Event>(new KeyUpEvent(wall_time(), sys.prefs->key(key))));
+        for (auto key : action->keys_up) {
+            _events.push(0, at, KeyUpEvent(wall_time(), sys.prefs->key(key)));
         }
     }
 }
@@ -124,10 +220,7 @@ bool ReplayInputSource::get(Handle<Admiral> admiral, game_ticks at, EventReceive
     if (_exit || (at >= _duration)) {
         return false;
     }
-    auto events = _events.equal_range(make_pair(admiral.number(), at));
-    for (auto it : range(events.first, events.second)) {
-        it->second->send(&receiver);
-    }
+    _events.send(admiral.number(), at, receiver);
     return true;
 }
 
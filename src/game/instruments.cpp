@@ -126,6 +126,7 @@ struct barIndicatorType {
 
 static ANTARES_GLOBAL unique_ptr<Scale[]> gScaleList;
 static ANTARES_GLOBAL int32_t gWhichScaleNum;
+static ANTARES_GLOBAL int32_t gScaleSum;  // sum of the factors in gScaleList
 static ANTARES_GLOBAL Rect view_range;
 static ANTARES_GLOBAL barIndicatorType gBarIndicator[kBarIndicatorNum];
 
@@ -178,6 +179,7 @@ void ResetInstruments() {
         *l = SCALE_SCALE;
         l++;
     }
+    gScaleSum = SCALE_SCALE.factor * kScaleListNum;
 
     for (i = 0; i < kBarIndicatorNum; i++) {
         gBarIndicator[i].thisValue = -1;
@@ -306,9 +308,9 @@ void UpdateRadar(ticks unitsDone) {
         } break;
     }
 
-    Scale* scaleval;
     for (ticks x = ticks(0); x < unitsDone; x++) {
-        scaleval  = gScaleList.get() + gWhichScaleNum;
+        Scale* scaleval = gScaleList.get() + gWhichScaleNum;
+        gScaleSum += bestScale.factor - scaleval->factor;
         *scaleval = bestScale;
         gWhichScaleNum++;
         if (gWhichScaleNum == kScaleListNum) {
@@ -316,12 +318,7 @@ void UpdateRadar(ticks unitsDone) {
         }
     }
 
-    scaleval = gScaleList.get();
-    Scale absolute_scale{0};
-    for (int oCount = 0; oCount < kScaleListNum; oCount++) {
-        absolute_scale.factor += scaleval++->factor;
-    }
-    absolute_scale.factor >>= kScaleListShift;
+    Scale absolute_scale{gScaleSum >> kScaleListShift};
 
     if ((gAbsoluteScale < kBlipThreshhold) != (absolute_scale < kBlipThreshhold)) {
         sys.sound.zoom();
@@ -357,12 +354,14 @@ void draw_radar() {
                     kRadarColor, ((kRadarColorSteps * g.radar_count) / kRadarSpeed) + 1);
         }
 
+        // UpdateRadar() fills blips from the front, so the first unused one ends the list.
         Points points;
         for (int rcount = 0; rcount < kRadarBlipNum; rcount++) {
             Point* lp = g.radar_blips.get() + rcount;
-            if (lp->h >= 0) {
-                points.draw(*lp, color);
+            if (lp->h < 0) {
+                break;
             }
+            points.draw(*lp, color);
         }
     } else {
         Rects().fill(bounds, darkest);
@@ -195,6 +195,7 @@ LoadState start_construct_level(const Level& level) {
     ResetMotionGlobals();
     plug.races.clear();
     plug.objects.clear();
+    plug.object_ids.clear();
     gAbsoluteScale = kTimesTwoScale;
     g.sync         = 0;
 
@@ -214,6 +215,13 @@ LoadState start_construct_level(const Level& level) {
         case Level::Type::NONE: throw std::runtime_error("level with type NONE?");
         case Level::Type::DEMO: construct_players(g.level->demo.players); break;
         case Level::Type::SOLO: construct_players(g.level->solo.players); break;
+        // LockstepSession (net/lockstep.hpp) can trade input with a peer, but nothing here uses
+        // it yet.  Playing a net level also needs:
+        //   * players built from NetLevel::Player, whose `races` isn't read from the level yet;
+        //   * PlayerShip driving an admiral other than g.admiral, for the peer's input;
+        //   * GamePlay pushing and polling the session on each major tick, and waiting for
+        //     ready() before running the tick;
+        //   * a way to pick a peer and input delay before the level starts.
         case Level::Type::NET: throw std::runtime_error("can’t construct net player");
     }
     // *** END INIT ADMIRALS ***
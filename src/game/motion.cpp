@@ -148,6 +148,21 @@ void ResetMotionGlobals() {
     g.farthest           = Handle<SpaceObject>(0);
 }
 
+// Adds `o`'s velocity to its motion fraction, and moves the whole part of the result from the
+// motion fraction to its location.  Returns the distance that was subtracted from the location.
+static Point step_object(SpaceObject* o) {
+    o->motionFraction.h += o->velocity.h;
+    o->motionFraction.v += o->velocity.v;
+
+    const Point step{rounded_fixed_to_long(o->motionFraction.h),
+                     rounded_fixed_to_long(o->motionFraction.v)};
+    o->location.h -= step.h;
+    o->location.v -= step.v;
+    o->motionFraction.h -= Fixed::from_long(step.h);
+    o->motionFraction.v -= Fixed::from_long(step.v);
+    return step;
+}
+
 static void move_object(SpaceObject* o) {
     if ((o->maxVelocity == Fixed::zero()) && !(o->attributes & kCanTurn)) {
         return;
@@ -156,12 +171,7 @@ static void move_object(SpaceObject* o) {
     if (o->attributes & kCanTurn) {
         o->turnFraction += o->turnVelocity;
 
-        int32_t h;
-        if (o->turnFraction >= Fixed::zero()) {
-            h = more_evil_fixed_to_long(o->turnFraction + Fixed::from_float(0.5));
-        } else {
-            h = more_evil_fixed_to_long(o->turnFraction - Fixed::from_float(0.5)) + 1;
-        }
+        int32_t h = rounded_fixed_to_long(o->turnFraction);
         o->direction += h;
         o->turnFraction -= Fixed::from_long(h);
 
@@ -236,26 +246,7 @@ static void move_object(SpaceObject* o) {
         o->velocity.v += fb;
     }
 
-    o->motionFraction.h += o->velocity.h;
-    o->motionFraction.v += o->velocity.v;
-
-    int32_t h;
-    if (o->motionFraction.h >= Fixed::zero()) {
-        h = more_evil_fixed_to_long(o->motionFraction.h + Fixed::from_float(0.5));
-    } else {
-        h = more_evil_fixed_to_long(o->motionFraction.h - Fixed::from_float(0.5)) + 1;
-    }
-    o->location.h -= h;
-    o->motionFraction.h -= Fixed::from_long(h);
-
-    int32_t v;
-    if (o->motionFraction.v >= Fixed::zero()) {
-        v = more_evil_fixed_to_long(o->motionFraction.v + Fixed::from_float(0.5));
-    } else {
-        v = more_evil_fixed_to_long(o->motionFraction.v - Fixed::from_float(0.5)) + 1;
-    }
-    o->location.v -= v;
-    o->motionFraction.v -= Fixed::from_long(v);
+    step_object(o);
 }
 
 static void bounce_object(SpaceObject* o) {
@@ -710,8 +701,11 @@ static void calc_bounds() {
     }
 }
 
-static bool can_hit(const SpaceObject& a, const SpaceObject& b) {
-    return (a.attributes & kCanCollide) && (b.attributes & kCanBeHit);
+// Returns the attributes that `b` needs at least one of to collide with `a`: objects that can
+// collide hit objects that can be hit, and vice versa.  Zero if `a` can neither hit nor be hit.
+static uint32_t hit_partner_mask(const SpaceObject& a) {
+    return ((a.attributes & kCanCollide) ? kCanBeHit : 0) |
+           ((a.attributes & kCanBeHit) ? kCanCollide : 0);
 }
 
 // Call HitObject() and CorrectPhysicalSpace() for all colliding pairs of objects.
@@ -720,6 +714,10 @@ static void calc_impacts(Handle<SpaceObject> near_objects[PROXIMITY_GRID_AREA])
         const auto*  cells = kAdjacentCells.at[i];
         SpaceObject* a     = nullptr;
         for (auto a_handle = near_objects[i]; (a = a_handle.get()); a_handle = a->nextNearObject) {
+            if (!hit_partner_mask(*a)) {
+                // Objects that only think are in the grid too; skip the scan for them.
+                continue;
+            }
             for (int32_t k = 0; k < AdjacentCells::size; k++) {
                 Handle<SpaceObject> b_handle = a->nextNearObject;
                 Point               super    = a->collisionGrid;
@@ -731,10 +729,10 @@ static void calc_impacts(Handle<SpaceObject> near_objects[PROXIMITY_GRID_AREA])
 
                 SpaceObject* b = nullptr;
                 for (; (b = b_handle.get()); b_handle = b->nextNearObject) {
-                    if ((!can_hit(*a, *b) &&
-                         !can_hit(*b, *a)) ||           // neither object can hit the other
-                        (b->collisionGrid != super) ||  // not near enough
-                        (a->owner == b->owner)) {       // same owner
+                    // a's attributes are re-read for each b, since HitObject() can change them.
+                    if (!(b->attributes & hit_partner_mask(*a)) ||  // neither can hit the other
+                        (b->collisionGrid != super) ||              // not near enough
+                        (a->owner == b->owner)) {                   // same owner
                         continue;
                     }
 
@@ -915,28 +913,8 @@ static void adjust_velocity(SpaceObject* o, int16_t angle, Fixed totalMass, Fixe
 }
 
 static void push(SpaceObject* o) {
-    o->motionFraction.h += o->velocity.h;
-    o->motionFraction.v += o->velocity.v;
-
-    int32_t h;
-    if (o->motionFraction.h >= Fixed::zero()) {
-        h = more_evil_fixed_to_long(o->motionFraction.h + Fixed::from_float(0.5));
-    } else {
-        h = more_evil_fixed_to_long(o->motionFraction.h - Fixed::from_float(0.5)) + 1;
-    }
-    o->location.h -= h;
-    o->motionFraction.h -= Fixed::from_long(h);
-
-    int32_t v;
-    if (o->motionFraction.v >= Fixed::zero()) {
-        v = more_evil_fixed_to_long(o->motionFraction.v + Fixed::from_float(0.5));
-    } else {
-        v = more_evil_fixed_to_long(o->motionFraction.v - Fixed::from_float(0.5)) + 1;
-    }
-    o->location.v -= v;
-    o->motionFraction.v -= Fixed::from_long(v);
-
-    o->absoluteBounds.offset(-h, -v);
+    Point step = step_object(o);
+    o->absoluteBounds.offset(-step.h, -step.v);
 }
 
 // CorrectPhysicalSpace-- takes 2 objects that are colliding and moves them back 1
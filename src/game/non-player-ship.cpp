@@ -203,8 +203,13 @@ void NonplayerShipThink() {
         Handle<Admiral>(count)->shipsLeft() = 0;
     }
 
-    // it probably doesn't matter what order we do this in, but we'll do
-    // it in the "ideal" order anyway
+    // The order matters, and this loop can't be split into independent per-object passes. An
+    // object's think reads state that objects earlier in the list wrote in the same pass (the
+    // target's `direction` and `keysDown`, the destination's `destObject`), and it writes the
+    // state of other objects and admirals: `exec()` of arrive and weapon actions,
+    // TogglePlayerAutoPilot(), warp flares from CreateAnySpaceObject(), and `shipsLeft`, which
+    // conditions checked by those actions can see while it is only partially counted. Replays
+    // depend on all of it.
     SpaceObject* o = nullptr;
     for (auto o_handle = g.root; (o = o_handle.get()); o_handle = o->nextObject) {
         if (!o->active) {
@@ -18,6 +18,7 @@
 
 #include "game/space-object.hpp"
 
+#include <map>
 #include <pn/output>
 #include <set>
 
@@ -80,6 +81,16 @@ void ResetAllSpaceObjects() {
     }
 }
 
+static BaseObject* object_for_id(int id) {
+    if ((id < 0) || (id >= plug.object_ids.size())) {
+        return nullptr;
+    }
+    return plug.object_ids[id];
+}
+
+template <>
+const BaseObject* NamedHandle<const BaseObject>::get() const { return object_for_id(_id); }
+
 BaseObject* BaseObject::get(int number) { return get(pn::dump(number, pn::dump_short)); }
 
 BaseObject* BaseObject::get(pn::string_view name) {
@@ -90,22 +101,36 @@ BaseObject* BaseObject::get(pn::string_view name) {
     return nullptr;
 }
 
+// Returns the handle for "{race}/{name}", building the name only the first time that the pair
+// is seen.  The admiral AI asks for these on every think.
+static const NamedHandle<const BaseObject>& race_object(
+        const NamedHandle<const Race>& race, const BuildableObject& o) {
+    static ANTARES_GLOBAL std::map<std::pair<int, int>, NamedHandle<const BaseObject>> handles;
+
+    std::pair<int, int> key{race.id(), o.id};
+    auto                it = handles.find(key);
+    if (it == handles.end()) {
+        NamedHandle<const BaseObject> handle{pn::format("{0}/{1}", race.name(), o.name)};
+        it = handles.emplace(key, std::move(handle)).first;
+    }
+    return it->second;
+}
+
 NamedHandle<const BaseObject> get_buildable_object_handle(
         const BuildableObject& o, const NamedHandle<const Race>& race) {
-    pn::string race_object = pn::format("{0}/{1}", race.name(), o.name);
-    if (Resource::object_exists(race_object)) {
-        return NamedHandle<const BaseObject>(race_object);
+    const NamedHandle<const BaseObject>& handle = race_object(race, o);
+    if (Resource::object_exists(handle.name())) {
+        return handle.copy();
     }
     return NamedHandle<const BaseObject>(o.name.copy());
 }
 
 const BaseObject* get_buildable_object(
         const BuildableObject& o, const NamedHandle<const Race>& race) {
-    pn::string race_object = pn::format("{0}/{1}", race.name(), o.name);
-    if (auto base = BaseObject::get(race_object)) {
+    if (auto base = race_object(race, o).get()) {
         return base;
     }
-    return BaseObject::get(o.name);
+    return object_for_id(o.id);
 }
 
 static Handle<SpaceObject> next_free_space_object() {
@@ -839,14 +864,21 @@ Fixed SpaceObject::turn_rate() const { return base->turn_rate; }
 int32_t SpaceObject::number() const { return this - g.objects.get(); }
 
 bool tags_match(const BaseObject& o, const Tags& query) {
-    for (const auto& kv : query.tags) {
-        auto it      = o.tags.tags.find(kv.first);
-        bool has_tag = ((it != o.tags.tags.end()) && it->second);
-        if (kv.second != has_tag) {
-            return false;
+    if (query.unnumbered) {
+        // Some of `query`'s tags have no bits, so compare them by name.
+        for (const auto& kv : query.tags) {
+            auto it      = o.tags.tags.find(kv.first);
+            bool has_tag = ((it != o.tags.tags.end()) && it->second);
+            if (kv.second != has_tag) {
+                return false;
+            }
         }
+        return true;
     }
-    return true;
+
+    // Each tag in `query` must be true on `o` if it's true in `query`, and absent or false on `o`
+    // otherwise.  All of `query`'s tags have bits, so any on `o` without one don't matter.
+    return (o.tags.set & query.mask) == query.set;
 }
 
 sfz::optional<pn::string_view> sprite_resource(const BaseObject& o) {
@@ -23,8 +23,9 @@
 #include <neon/ne_session.h>
 #include <neon/ne_uri.h>
 #include <unistd.h>
+#include <functional>
 #include <memory>
-#include <pn/output>
+#include <pn/data>
 #include <pn/string>
 
 using std::unique_ptr;
@@ -35,26 +36,33 @@ namespace antares {
 namespace http {
 
 struct ne_userdata {
-    pn::output_view out;
-    size_t          total;
+    const std::function<void(pn::data_view)>* write;
+    int64_t                                   skip;  // bytes still to drop before writing.
 };
 
 static int accept(void* userdata, ne_request* req, const ne_status* st) {
-    ne_userdata* u   = reinterpret_cast<ne_userdata*>(userdata);
-    auto         len = ne_get_response_header(req, "Content-Length");
-    (void)u;
-    (void)len;
-    return true;
+    ne_userdata* u = reinterpret_cast<ne_userdata*>(userdata);
+    if (st->code == 206) {
+        u->skip = 0;  // server honored the Range header.
+        return true;
+    }
+    return st->code == 200;
 }
 
 static int reader(void* userdata, const char* buf, size_t len) {
     ne_userdata* u = reinterpret_cast<ne_userdata*>(userdata);
-    u->total += len;
-    u->out.write(pn::data_view{reinterpret_cast<const uint8_t*>(buf), static_cast<int>(len)});
+    if (u->skip >= static_cast<int64_t>(len)) {
+        u->skip -= len;
+        return 0;
+    }
+    buf += u->skip;
+    len -= u->skip;
+    u->skip = 0;
+    (*u->write)(pn::data_view{reinterpret_cast<const uint8_t*>(buf), static_cast<int>(len)});
     return 0;
 }
 
-void get(pn::string_view url, pn::output_view out) {
+void get(pn::string_view url, int64_t offset, const std::function<void(pn::data_view)>& write) {
     static int inited = ne_sock_init();
     if (inited != 0) {
         throw std::runtime_error("ne_sock_init()");
@@ -76,14 +84,19 @@ void get(pn::string_view url, pn::output_view out) {
         ne_redirect_register(sess.get());
         unique_ptr<ne_request, decltype(&ne_request_destroy)> req(
                 ne_request_create(sess.get(), "GET", uri.path), ne_request_destroy);
+        if (offset > 0) {
+            ne_add_request_header(req.get(), "Range", pn::format("bytes={0}-", offset).c_str());
+        }
 
-        ne_userdata userdata = {out};
+        ne_userdata userdata = {&write, offset};
         ne_add_response_body_reader(req.get(), accept, reader, &userdata);
 
         switch (ne_request_dispatch(req.get())) {
             case NE_OK: {
                 const auto* st = ne_get_status(req.get());
-                if (st->code != 200) {
+                if (st->code == 416) {
+                    return;  // `offset` is at or past the end; there is nothing left to get.
+                } else if ((st->code != 200) && (st->code != 206)) {
                     throw std::runtime_error(pn::format("HTTP error {0}", st->code).c_str());
                 }
                 return;
@@ -19,7 +19,9 @@
 #include "net/http.hpp"
 
 #include <CoreFoundation/CoreFoundation.h>
-#include <pn/output>
+#include <functional>
+#include <pn/data>
+#include <pn/string>
 
 #include "mac/core-foundation.hpp"
 #include "net/http.hpp"
@@ -27,13 +29,18 @@
 namespace antares {
 namespace http {
 
-void get(pn::string_view url, pn::output_view out) {
+void get(pn::string_view url, int64_t offset, const std::function<void(pn::data_view)>& write) {
+    // CFURLCreateDataAndPropertiesFromResource() can't make range requests, so fetch the whole
+    // body and drop what the caller already has.
     cf::Url  cfurl(url);
     cf::Data cfdata;
     SInt32   error;
     if (CFURLCreateDataAndPropertiesFromResource(
                 NULL, cfurl.c_obj(), &cfdata.c_obj(), NULL, NULL, &error)) {
-        out.write(cfdata.data());
+        pn::data_view data = cfdata.data();
+        if (offset < data.size()) {
+            write(data.slice(static_cast<int>(offset), data.size() - static_cast<int>(offset)));
+        }
     } else {
         throw std::runtime_error(pn::format("Couldn't load requested url {0}", url).c_str());
     }
@@ -19,6 +19,7 @@
 #include "math/fixed.hpp"
 
 #include <gmock/gmock.h>
+#include <limits>
 
 using testing::Eq;
 using testing::Ge;
@@ -157,5 +158,36 @@ TEST_F(FixedTest, Math) {
     EXPECT_THAT(Fixed::from_long(2) << 1, Eq(Fixed::from_long(4)));
 }
 
+TEST_F(FixedTest, Round) {
+    EXPECT_EQ(-2, rounded_fixed_to_long(Fixed::from_val(-385)));
+    EXPECT_EQ(-1, rounded_fixed_to_long(Fixed::from_val(-384)));
+    EXPECT_EQ(-1, rounded_fixed_to_long(Fixed::from_val(-129)));
+    EXPECT_EQ(0, rounded_fixed_to_long(Fixed::from_val(-128)));
+    EXPECT_EQ(0, rounded_fixed_to_long(Fixed::from_val(0)));
+    EXPECT_EQ(0, rounded_fixed_to_long(Fixed::from_val(127)));
+    EXPECT_EQ(1, rounded_fixed_to_long(Fixed::from_val(128)));
+    EXPECT_EQ(1, rounded_fixed_to_long(Fixed::from_val(383)));
+    EXPECT_EQ(2, rounded_fixed_to_long(Fixed::from_val(384)));
+
+    // Must match the two-armed rounding that motion.cpp used to do, so that replays still play
+    // back the same way.  Check every value near zero, and a spread of values across the range.
+    auto reference = [](Fixed value) -> int32_t {
+        if (value >= Fixed::zero()) {
+            return more_evil_fixed_to_long(value + Fixed::from_float(0.5));
+        } else {
+            return more_evil_fixed_to_long(value - Fixed::from_float(0.5)) + 1;
+        }
+    };
+    for (int32_t i = -0x10000; i <= 0x10000; ++i) {
+        ASSERT_EQ(reference(Fixed::from_val(i)), rounded_fixed_to_long(Fixed::from_val(i))) << i;
+    }
+    const int32_t min = std::numeric_limits<int32_t>::min() + 128;
+    const int32_t max = std::numeric_limits<int32_t>::max() - 128;
+    for (int64_t i = min; i <= max; i += 65521) {
+        Fixed value = Fixed::from_val(i);
+        ASSERT_EQ(reference(value), rounded_fixed_to_long(value)) << i;
+    }
+}
+
 }  // namespace
 }  // namespace antares
@@ -0,0 +1,266 @@
+// Copyright (C) 2018 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "net/http.hpp"
+
+#include <errno.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <gmock/gmock.h>
+#include <pn/data>
+#include <pn/string>
+#include <sfz/sfz.hpp>
+#include <stdexcept>
+#include <string>
+
+#include "data/extractor.hpp"
+
+using testing::Eq;
+
+namespace antares {
+namespace {
+
+// Serves `body` at every path on 127.0.0.1, from a child process that runs until the server is
+// destroyed.
+class Server {
+  public:
+    enum Ranges { HONOR_RANGES, IGNORE_RANGES };
+
+    Server(const std::string& body, Ranges ranges) {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        check(fd >= 0, "socket", -1);
+
+        sockaddr_in addr     = {};
+        addr.sin_family      = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t size       = sizeof(addr);
+        check(bind(fd, reinterpret_cast<sockaddr*>(&addr), size) == 0, "bind", fd);
+        check(listen(fd, 4) == 0, "listen", fd);
+        check(getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &size) == 0, "getsockname", fd);
+        _port = ntohs(addr.sin_port);
+
+        _pid = fork();
+        check(_pid >= 0, "fork", fd);
+        if (_pid == 0) {
+            signal(SIGPIPE, SIG_IGN);
+            while (true) {
+                int conn = accept(fd, nullptr, nullptr);
+                if (conn >= 0) {
+                    serve(conn, body, ranges);
+                    close(conn);
+                }
+            }
+        }
+        close(fd);
+    }
+
+    ~Server() {
+        if (_pid > 0) {
+            kill(_pid, SIGTERM);
+            waitpid(_pid, nullptr, 0);
+        }
+    }
+
+    pn::string url() const { return pn::format("http://127.0.0.1:{0}", _port); }
+
+  private:
+    // Throws if setup failed, so that the test stops there instead of talking to no server.
+    static void check(bool ok, const char* what, int fd) {
+        if (!ok) {
+            int error = errno;
+            if (fd >= 0) {
+                close(fd);
+            }
+            throw std::runtime_error(pn::format("{0}: {1}", what, strerror(error)).c_str());
+        }
+    }
+
+    static void serve(int conn, const std::string& body, Ranges ranges) {
+        std::string request;
+        char        buf[1024];
+        while (request.find("\r\n\r\n") == request.npos) {
+            ssize_t n = read(conn, buf, sizeof(buf));
+            if (n <= 0) {
+                return;
+            }
+            request.append(buf, n);
+        }
+
+        std::string status  = "200 OK";
+        std::string content = body;
+        size_t      range   = request.find("\r\nRange: bytes=");
+        if ((ranges == HONOR_RANGES) && (range != request.npos)) {
+            size_t offset = strtoul(request.c_str() + range + 15, nullptr, 10);
+            if (offset >= body.size()) {
+                status  = "416 Range Not Satisfiable";
+                content = "";
+            } else {
+                status  = "206 Partial Content";
+                content = body.substr(offset);
+            }
+        }
+
+        std::string response = "HTTP/1.1 " + status + "\r\n";
+        response += "Content-Length: " + std::to_string(content.size()) + "\r\n";
+        response += "Connection: close\r\n\r\n";
+        response += content;
+        for (size_t sent = 0; sent < response.size();) {
+            ssize_t n = write(conn, response.data() + sent, response.size() - sent);
+            if (n <= 0) {
+                return;
+            }
+            sent += n;
+        }
+    }
+
+    int   _port;
+    pid_t _pid = -1;
+};
+
+// Long enough to arrive in more than one piece.
+std::string test_body() {
+    std::string body;
+    for (int i = 0; i < 100000; ++i) {
+        body.push_back((i * 7) % 251);
+    }
+    return body;
+}
+
+std::string get(pn::string_view url, int64_t offset) {
+    std::string result;
+    http::get(url, offset, [&result](pn::data_view data) {
+        result.append(reinterpret_cast<const char*>(data.data()), data.size());
+    });
+    return result;
+}
+
+sfz::sha1::digest digest(const std::string& s) {
+    sfz::sha1 sha;
+    sha.write(pn::data_view{
+            reinterpret_cast<const uint8_t*>(s.data()), static_cast<int>(s.size())});
+    return sha.compute();
+}
+
+std::string read_file(pn::string_view path) {
+    std::string                              result;
+    std::unique_ptr<FILE, decltype(&fclose)> file(fopen(path.copy().c_str(), "rb"), fclose);
+    char                                     buf[1024];
+    size_t                                   n;
+    while (file && ((n = fread(buf, 1, sizeof(buf), file.get())) > 0)) {
+        result.append(buf, n);
+    }
+    return result;
+}
+
+void write_file(pn::string_view path, const std::string& data) {
+    std::unique_ptr<FILE, decltype(&fclose)> file(fopen(path.copy().c_str(), "wb"), fclose);
+    ASSERT_THAT(fwrite(data.data(), 1, data.size(), file.get()), Eq(data.size()));
+}
+
+using HttpTest = testing::Test;
+
+TEST_F(HttpTest, Whole) {
+    std::string body = test_body();
+    Server      server(body, Server::HONOR_RANGES);
+    EXPECT_THAT(get(server.url(), 0), Eq(body));
+}
+
+// The server honors the Range header and sends 206 with only the rest.
+TEST_F(HttpTest, Resume) {
+    std::string body = test_body();
+    Server      server(body, Server::HONOR_RANGES);
+    EXPECT_THAT(get(server.url(), 12345), Eq(body.substr(12345)));
+}
+
+// The server ignores the Range header and sends 200 with the whole body; the part that was
+// already there is dropped.
+TEST_F(HttpTest, ResumeIgnored) {
+    std::string body = test_body();
+    Server      server(body, Server::IGNORE_RANGES);
+    EXPECT_THAT(get(server.url(), 12345), Eq(body.substr(12345)));
+}
+
+// The offset is already at the end, and the server says so with 416.
+TEST_F(HttpTest, ResumeAtEnd) {
+    std::string body = test_body();
+    Server      server(body, Server::HONOR_RANGES);
+    EXPECT_THAT(get(server.url(), body.size()), Eq(""));
+}
+
+class DownloadTest : public testing::Test {
+  protected:
+    struct NullObserver : DataExtractor::Observer {
+        virtual void status(pn::string_view status) {}
+    };
+
+    // extract() always downloads from arescentral.org; this reaches the step underneath it.
+    struct TestExtractor : DataExtractor {
+        using DataExtractor::DataExtractor;
+        using DataExtractor::download;
+    };
+
+    void SetUp() override {
+        char dir[] = "/tmp/antares-download-test.XXXXXX";
+        ASSERT_THAT(mkdtemp(dir), testing::NotNull());
+        _dir       = dir;
+        _full_path = pn::format("{0}/Ares/Ares-1.2.0.zip", _dir);
+        _part_path = pn::format("{0}.part", _full_path);
+    }
+
+    void TearDown() override { sfz::rmtree(_dir); }
+
+    void download(pn::string_view url, const sfz::sha1::digest& digest) {
+        TestExtractor extractor(pn::format("{0}/Ares", _dir), pn::format("{0}/out", _dir));
+        NullObserver  observer;
+        extractor.download(&observer, url, "Ares", "1.2.0", digest);
+    }
+
+    pn::string _dir;
+    pn::string _full_path;
+    pn::string _part_path;
+};
+
+// A .part file left by an interrupted download is resumed from, and moved into place once the
+// whole file is there.
+TEST_F(DownloadTest, Resume) {
+    std::string body = test_body();
+    Server      server(body, Server::HONOR_RANGES);
+    sfz::makedirs(pn::format("{0}/Ares", _dir), 0755);
+    write_file(_part_path, body.substr(0, 12345));
+
+    download(server.url(), digest(body));
+    EXPECT_THAT(read_file(_full_path), Eq(body));
+    EXPECT_THAT(sfz::path::exists(_part_path), Eq(false));
+}
+
+// If the whole file has the wrong digest, it's deleted, so the next attempt starts over.
+TEST_F(DownloadTest, BadDigest) {
+    std::string body = test_body();
+    Server      server(body, Server::HONOR_RANGES);
+    EXPECT_THROW(download(server.url(), digest("not the body")), std::runtime_error);
+    EXPECT_THAT(sfz::path::exists(_part_path), Eq(false));
+    EXPECT_THAT(sfz::path::exists(_full_path), Eq(false));
+}
+
+}  // namespace
+}  // namespace antares
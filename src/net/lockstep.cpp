@@ -0,0 +1,389 @@
+// Copyright (C) 2018 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "net/lockstep.hpp"
+
+#include <algorithm>
+#include <pn/output>
+
+namespace antares {
+
+namespace {
+
+// Packets are encoded like replays (see data/replay.cpp): a sequence of fields, each a varint
+// tag followed by a value whose encoding is given by the tag's wire type.
+enum {
+    VARINT           = 0,
+    FIXED64          = 1,
+    LENGTH_DELIMITED = 2,
+    FIXED32          = 5,
+};
+
+enum {
+    PACKET_INPUT_DELAY = (0x01 << 3) | VARINT,
+    PACKET_ACK         = (0x02 << 3) | VARINT,
+    PACKET_FRAME       = (0x03 << 3) | LENGTH_DELIMITED,
+
+    FRAME_AT       = (0x01 << 3) | VARINT,
+    FRAME_SYNC     = (0x02 << 3) | VARINT,
+    FRAME_KEY_DOWN = (0x03 << 3) | VARINT,
+    FRAME_KEY_UP   = (0x04 << 3) | VARINT,
+};
+
+void write_varint(pn::output_view out, uint64_t value) {
+    do {
+        uint8_t byte = value & 0x7f;
+        value >>= 7;
+        if (value) {
+            byte |= 0x80;
+        }
+        out.write(pn::data_view{&byte, 1});
+    } while (value != 0);
+}
+
+void tag_varint(pn::output_view out, uint64_t tag, uint64_t value) {
+    write_varint(out, tag);
+    write_varint(out, value);
+}
+
+void tag_bytes(pn::output_view out, uint64_t tag, pn::data_view bytes) {
+    write_varint(out, tag);
+    write_varint(out, bytes.size());
+    out.write(bytes);
+}
+
+// Reads the fields of a packet, or of a frame within one.  The bytes come off the network, so
+// every read is checked against what's left, and fails instead of reading past the end.
+class FieldReader {
+  public:
+    explicit FieldReader(pn::data_view bytes)
+            : _p(bytes.data()), _end(bytes.data() + bytes.size()) {}
+
+    bool done() const { return _p == _end; }
+
+    bool varint(uint64_t* out) {
+        *out = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (_p == _end) {
+                return false;
+            }
+            uint8_t byte = *(_p++);
+            if ((shift == 63) && (byte > 1)) {
+                return false;  // more than 64 bits.
+            }
+            *out |= uint64_t(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool bytes(pn::data_view* out) {
+        uint64_t size;
+        if (!varint(&size) || (size > (_end - _p))) {
+            return false;
+        }
+        *out = pn::data_view{_p, static_cast<int>(size)};
+        _p += size;
+        return true;
+    }
+
+    // Skips the value of a field this version doesn't know about.
+    bool skip(uint64_t tag) {
+        uint64_t      value;
+        pn::data_view bytes;
+        switch (tag & 0x7) {
+            case VARINT: return varint(&value);
+            case FIXED64: return skip_fixed(8);
+            case LENGTH_DELIMITED: return this->bytes(&bytes);
+            case FIXED32: return skip_fixed(4);
+            default: return false;
+        }
+    }
+
+  private:
+    bool skip_fixed(int size) {
+        if (size > (_end - _p)) {
+            return false;
+        }
+        _p += size;
+        return true;
+    }
+
+    const uint8_t* _p;
+    const uint8_t* _end;
+};
+
+bool read_key(FieldReader* in, std::vector<uint8_t>* keys) {
+    uint64_t key;
+    if (!in->varint(&key) || (key > 0xff)) {
+        return false;
+    }
+    keys->push_back(key);
+    return true;
+}
+
+}  // namespace
+
+LockstepTransport::~LockstepTransport() {}
+
+LockstepSession::LockstepSession(LockstepTransport* transport, int64_t input_delay, int redundancy)
+        : _transport(transport),
+          _input_delay(input_delay),
+          _redundancy(redundancy),
+          _remote_next(input_delay),
+          _acked(input_delay) {
+    for (int64_t tick = 0; tick < _input_delay; ++tick) {
+        Frame frame;
+        frame.sync     = 0;
+        frame.input.at = tick;
+        _local.push_back(frame);
+        _sent.push_back(wall_time{});
+        _remote[tick] = frame;
+    }
+}
+
+void LockstepSession::push(
+        int64_t tick, uint32_t sync, const ReplayData::Action& input, wall_time at) {
+    if (tick + _input_delay != _local.size()) {
+        throw std::runtime_error(
+                pn::format("pushed tick {0}, expected {1}", tick, _local.size() - _input_delay)
+                        .c_str());
+    }
+    if (_stats.size() <= tick) {
+        _stats.emplace_back();
+    }
+
+    Frame frame;
+    frame.sync     = sync;
+    frame.input    = input;
+    frame.input.at = tick + _input_delay;
+    _local.push_back(std::move(frame));
+    _sent.push_back(at);
+    check_sync(tick + _input_delay);
+    send(at);
+}
+
+void LockstepSession::poll(wall_time at) {
+    pn::data packet;
+    while (_transport->receive(&packet)) {
+        receive(packet, at);
+    }
+    if (!_last_send.has_value() || ((at - *_last_send) >= kMajorTick)) {
+        send(at);
+    }
+}
+
+bool LockstepSession::ready(int64_t tick) const {
+    return (tick < _remote_next) || (_remote.find(tick) != _remote.end());
+}
+
+const ReplayData::Action& LockstepSession::local(int64_t tick) const {
+    return _local.at(tick).input;
+}
+
+const ReplayData::Action& LockstepSession::remote(int64_t tick) const {
+    return _remote.at(tick).input;
+}
+
+const LockstepSession::Stats& LockstepSession::stats(int64_t tick) const {
+    static const Stats empty;
+    if ((tick < 0) || (tick >= _stats.size())) {
+        return empty;
+    }
+    return _stats[tick];
+}
+
+void LockstepSession::send(wall_time at) {
+    pn::data   packet;
+    pn::output out = packet.output();
+    tag_varint(out, PACKET_INPUT_DELAY, _input_delay);
+    tag_varint(out, PACKET_ACK, _remote_next);
+    int64_t end = std::min<int64_t>(_acked + _redundancy, _local.size());
+    for (int64_t tick = _acked; tick < end; ++tick) {
+        const Frame& frame = _local[tick];
+        pn::data     bytes;
+        pn::output   frame_out = bytes.output();
+        tag_varint(frame_out, FRAME_AT, frame.input.at);
+        tag_varint(frame_out, FRAME_SYNC, frame.sync);
+        for (uint8_t key : frame.input.keys_down) {
+            tag_varint(frame_out, FRAME_KEY_DOWN, key);
+        }
+        for (uint8_t key : frame.input.keys_up) {
+            tag_varint(frame_out, FRAME_KEY_UP, key);
+        }
+        tag_bytes(out, PACKET_FRAME, bytes);
+    }
+
+    _transport->send(packet);
+    _last_send   = at;
+    Stats& stats = current_stats();
+    ++stats.packets_sent;
+    stats.bytes_sent += packet.size();
+}
+
+void LockstepSession::receive(pn::data_view bytes, wall_time at) {
+    Stats& stats = current_stats();
+    ++stats.packets_received;
+    stats.bytes_received += bytes.size();
+
+    Packet packet;
+    if (!read_packet(bytes, &packet)) {
+        ++stats.packets_dropped;
+        return;
+    } else if (packet.input_delay != _input_delay) {
+        throw std::runtime_error(
+                pn::format(
+                        "peer has input delay {0}, but ours is {1}", int64_t(packet.input_delay),
+                        _input_delay)
+                        .c_str());
+    }
+
+    // The peer can't push tick `t` until it has our frame for `t`, which we send on tick
+    // `t - input_delay`, so a frame for `_local.size() + input_delay` or later (or an ack past
+    // `_local.size()`) can't be from a peer playing the same game.
+    for (const Frame& frame : packet.frames) {
+        if (frame.input.at >= (_local.size() + _input_delay)) {
+            ++stats.packets_dropped;
+            return;
+        }
+    }
+    if (packet.ack > _local.size()) {
+        ++stats.packets_dropped;
+        return;
+    }
+
+    for (; _acked < packet.ack; ++_acked) {
+        _stats[_acked - _input_delay].latency = at - _sent[_acked];
+    }
+    for (Frame& frame : packet.frames) {
+        int64_t tick = frame.input.at;
+        if (!ready(tick)) {
+            _remote[tick] = std::move(frame);
+            check_sync(tick);
+            while (_remote.find(_remote_next) != _remote.end()) {
+                ++_remote_next;
+            }
+        }
+    }
+}
+
+bool LockstepSession::read_packet(pn::data_view bytes, Packet* packet) {
+    FieldReader in(bytes);
+    bool        has_input_delay = false;
+    while (!in.done()) {
+        uint64_t      tag;
+        pn::data_view frame;
+        if (!in.varint(&tag)) {
+            return false;
+        }
+        switch (tag) {
+            case PACKET_INPUT_DELAY:
+                if (!in.varint(&packet->input_delay)) {
+                    return false;
+                }
+                has_input_delay = true;
+                break;
+
+            case PACKET_ACK:
+                if (!in.varint(&packet->ack)) {
+                    return false;
+                }
+                break;
+
+            case PACKET_FRAME:
+                packet->frames.emplace_back();
+                if (!in.bytes(&frame) || !read_frame(frame, &packet->frames.back())) {
+                    return false;
+                }
+                break;
+
+            default:
+                if (!in.skip(tag)) {
+                    return false;
+                }
+                break;
+        }
+    }
+    return has_input_delay;
+}
+
+bool LockstepSession::read_frame(pn::data_view bytes, Frame* frame) {
+    FieldReader in(bytes);
+    bool        has_at = false;
+    while (!in.done()) {
+        uint64_t tag, value;
+        if (!in.varint(&tag)) {
+            return false;
+        }
+        switch (tag) {
+            case FRAME_AT:
+                if (!in.varint(&frame->input.at)) {
+                    return false;
+                }
+                has_at = true;
+                break;
+
+            case FRAME_SYNC:
+                if (!in.varint(&value) || (value > 0xffffffff)) {
+                    return false;
+                }
+                frame->sync = value;
+                break;
+
+            case FRAME_KEY_DOWN:
+                if (!read_key(&in, &frame->input.keys_down)) {
+                    return false;
+                }
+                break;
+
+            case FRAME_KEY_UP:
+                if (!read_key(&in, &frame->input.keys_up)) {
+                    return false;
+                }
+                break;
+
+            default:
+                if (!in.skip(tag)) {
+                    return false;
+                }
+                break;
+        }
+    }
+    return has_at;
+}
+
+void LockstepSession::check_sync(int64_t tick) const {
+    auto it = _remote.find(tick);
+    if ((tick < _input_delay) || (tick >= _local.size()) || (it == _remote.end())) {
+        return;
+    }
+    if (_local[tick].sync != it->second.sync) {
+        throw std::runtime_error(
+                pn::format("net game out of sync after tick {0}", tick - _input_delay).c_str());
+    }
+}
+
+LockstepSession::Stats& LockstepSession::current_stats() {
+    if (_stats.empty()) {
+        _stats.emplace_back();
+    }
+    return _stats.back();
+}
+
+}  // namespace antares
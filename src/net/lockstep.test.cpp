@@ -0,0 +1,278 @@
+// Copyright (C) 2018 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "net/lockstep.hpp"
+
+#include <gmock/gmock.h>
+#include <deque>
+#include <pn/output>
+#include <random>
+
+#ifndef _WIN32
+#include "net/udp.hpp"
+#endif
+
+using testing::ElementsAreArray;
+using testing::Eq;
+using testing::Gt;
+using testing::Lt;
+
+namespace antares {
+namespace {
+
+using LockstepTest = testing::Test;
+
+// Delivers packets between two sessions in memory, losing and reordering some of them.
+class Loopback : public LockstepTransport {
+  public:
+    Loopback(int loss_percent, uint32_t seed) : _loss_percent(loss_percent), _random(seed) {}
+
+    void connect(Loopback* peer) { _peer = peer; }
+
+    // Queues `packet` as if it had arrived from the peer.
+    void deliver(std::vector<uint8_t> packet) {
+        _inbox.emplace_back();
+        _inbox.back().output().write(
+                pn::data_view{packet.data(), static_cast<int>(packet.size())});
+    }
+
+    virtual void send(pn::data_view packet) {
+        if ((_random() % 100) < _loss_percent) {
+            return;
+        }
+        _peer->_inbox.emplace_back();
+        _peer->_inbox.back().output().write(packet);
+    }
+
+    virtual bool receive(pn::data* packet) {
+        if (_inbox.empty()) {
+            return false;
+        }
+        auto it = _inbox.begin() + (_random() % _inbox.size());
+        *packet = std::move(*it);
+        _inbox.erase(it);
+        return true;
+    }
+
+  private:
+    const int            _loss_percent;
+    std::minstd_rand     _random;
+    Loopback*            _peer = nullptr;
+    std::deque<pn::data> _inbox;
+};
+
+ReplayData::Action input(int player, int64_t tick) {
+    ReplayData::Action action;
+    action.at = tick;
+    if ((tick % 5) == player) {
+        action.keys_down.push_back((tick + player) % 32);
+    } else if ((tick % 5) == (player + 2)) {
+        action.keys_up.push_back((tick + player) % 32);
+    }
+    return action;
+}
+
+// Plays one side of a net game: waits for both players' input, folds it into `sync` as the
+// game would fold it into the game state, then makes the next input.
+struct Peer {
+    LockstepSession session;
+    int             player;
+    int64_t         tick         = 0;
+    uint32_t        sync         = 0;
+    int64_t         corrupt_tick = -1;
+
+    Peer(LockstepTransport* transport, int player, int64_t input_delay, int redundancy)
+            : session(transport, input_delay, redundancy), player(player) {}
+
+    void fold(const ReplayData::Action& action) {
+        for (uint8_t key : action.keys_down) {
+            sync = (sync * 31) + key + 1;
+        }
+        for (uint8_t key : action.keys_up) {
+            sync = (sync * 37) + key + 1;
+        }
+    }
+
+    void step(wall_time at) {
+        session.poll(at);
+        if (!session.ready(tick)) {
+            return;
+        }
+        fold((player == 0) ? session.local(tick) : session.remote(tick));
+        fold((player == 0) ? session.remote(tick) : session.local(tick));
+        if (tick == corrupt_tick) {
+            sync ^= 1;
+        }
+        session.push(tick, sync, input(player, tick), at);
+        ++tick;
+    }
+};
+
+// Runs both peers until each has pushed `ticks` ticks, advancing the clock by one major tick
+// each round.  Returns false if they stop making progress.
+bool run(Peer* a, Peer* b, int64_t ticks) {
+    wall_time at;
+    for (int round = 0; round < 100 * ticks; ++round) {
+        if ((a->tick >= ticks) && (b->tick >= ticks)) {
+            return true;
+        }
+        at += kMajorTick;
+        if (a->tick < ticks) {
+            a->step(at);
+        }
+        if (b->tick < ticks) {
+            b->step(at);
+        }
+    }
+    return false;
+}
+
+void expect_same_input(const Peer& a, const Peer& b, int64_t ticks) {
+    for (int64_t tick = 0; tick < ticks; ++tick) {
+        const ReplayData::Action& sent     = a.session.local(tick);
+        const ReplayData::Action& received = b.session.remote(tick);
+        EXPECT_THAT(received.at, Eq(tick));
+        EXPECT_THAT(received.keys_down, ElementsAreArray(sent.keys_down));
+        EXPECT_THAT(received.keys_up, ElementsAreArray(sent.keys_up));
+    }
+}
+
+TEST_F(LockstepTest, Delay) {
+    Loopback la(0, 1), lb(0, 2);
+    la.connect(&lb);
+    lb.connect(&la);
+    Peer a(&la, 0, 3, 4), b(&lb, 1, 3, 4);
+
+    // Neither side has input for the first ticks, so neither has to wait for them.
+    for (int64_t tick = 0; tick < 3; ++tick) {
+        EXPECT_THAT(a.session.ready(tick), Eq(true));
+        EXPECT_THAT(a.session.remote(tick).keys_down.size(), Eq(0));
+    }
+    EXPECT_THAT(a.session.ready(3), Eq(false));
+
+    // Input pushed on tick 0 applies on tick 3.
+    a.step(wall_time{});
+    EXPECT_THAT(a.session.local(3).at, Eq(3));
+    b.step(wall_time{});
+    EXPECT_THAT(b.session.ready(3), Eq(true));
+    EXPECT_THAT(b.session.ready(4), Eq(false));
+
+    ASSERT_THAT(run(&a, &b, 100), Eq(true));
+    expect_same_input(a, b, 100);
+    expect_same_input(b, a, 100);
+    EXPECT_THAT(a.sync, Eq(b.sync));
+}
+
+TEST_F(LockstepTest, Loss) {
+    Loopback la(40, 1), lb(40, 2);
+    la.connect(&lb);
+    lb.connect(&la);
+    Peer a(&la, 0, 2, 8), b(&lb, 1, 2, 8);
+
+    ASSERT_THAT(run(&a, &b, 500), Eq(true));
+    expect_same_input(a, b, 500);
+    expect_same_input(b, a, 500);
+    EXPECT_THAT(a.sync, Eq(b.sync));
+}
+
+TEST_F(LockstepTest, Desync) {
+    Loopback la(0, 1), lb(0, 2);
+    la.connect(&lb);
+    lb.connect(&la);
+    Peer a(&la, 0, 3, 4), b(&lb, 1, 3, 4);
+    b.corrupt_tick = 20;
+
+    EXPECT_THROW(run(&a, &b, 100), std::runtime_error);
+    EXPECT_THAT(a.tick, Lt(30));
+}
+
+TEST_F(LockstepTest, DelayMismatch) {
+    Loopback la(0, 1), lb(0, 2);
+    la.connect(&lb);
+    lb.connect(&la);
+    Peer a(&la, 0, 3, 4), b(&lb, 1, 4, 4);
+
+    EXPECT_THROW(run(&a, &b, 100), std::runtime_error);
+}
+
+TEST_F(LockstepTest, Stats) {
+    Loopback la(0, 1), lb(0, 2);
+    la.connect(&lb);
+    lb.connect(&la);
+    Peer a(&la, 0, 3, 4), b(&lb, 1, 3, 4);
+
+    ASSERT_THAT(run(&a, &b, 100), Eq(true));
+    for (int64_t tick = 0; tick < 90; ++tick) {
+        const LockstepSession::Stats& stats = a.session.stats(tick);
+        ASSERT_THAT(stats.latency.has_value(), Eq(true));
+        EXPECT_THAT(*stats.latency, Gt(usecs(0)));
+        EXPECT_THAT(stats.packets_sent, Gt(0));
+        EXPECT_THAT(stats.bytes_sent, Gt(0));
+        EXPECT_THAT(stats.packets_received, Gt(0));
+        EXPECT_THAT(stats.bytes_received, Gt(0));
+    }
+    EXPECT_THAT(a.session.stats(1000).packets_sent, Eq(0));
+}
+
+TEST_F(LockstepTest, BadPackets) {
+    Loopback la(0, 1), lb(0, 2);
+    la.connect(&lb);
+    lb.connect(&la);
+    Peer a(&la, 0, 3, 4), b(&lb, 1, 3, 4);
+
+    // Input delay 3, then:
+    la.deliver({0x08, 0x03, 0x10});                    // ack with no value
+    la.deliver({0x08, 0x03, 0x10, 0xff, 0xff, 0xff, 0xff, 0xff,
+                0xff, 0xff, 0xff, 0xff, 0xff, 0x01});  // ack of more than 64 bits
+    la.deliver({0x08, 0x03, 0x1a, 0xff, 0xff, 0xff, 0xff, 0xff,
+                0xff, 0xff, 0xff, 0xff, 0x01});        // frame of 2^64 - 1 bytes
+    la.deliver({0x08, 0x03, 0x1a, 0x03, 0x08, 0xe8, 0x07});  // frame for tick 1000
+    la.deliver({0x08, 0x03, 0x10, 0xe8, 0x07});              // ack of tick 1000
+    la.deliver({0x08, 0x03, 0x1a, 0x02, 0x18, 0x01});        // frame without a tick
+    la.deliver({0x08, 0x03, 0x1a, 0x05, 0x08, 0x03, 0x18, 0x80, 0x02});  // key 256
+    la.deliver({0x08, 0x03, 0x4f, 0x00});                    // field with wire type 7
+    la.deliver({});                                          // no input delay
+    a.session.poll(wall_time{});
+    EXPECT_THAT(a.session.stats(0).packets_received, Eq(9));
+    EXPECT_THAT(a.session.stats(0).packets_dropped, Eq(9));
+    EXPECT_THAT(a.session.ready(3), Eq(false));
+
+    // Fields this version doesn't know about are skipped.
+    la.deliver({0x08, 0x03, 0x4d, 0x01, 0x02, 0x03, 0x04, 0x1a, 0x07,
+                0x08, 0x03, 0x52, 0x01, 0x00, 0x18, 0x00});  // frame for tick 3, with key 0 down
+    a.session.poll(wall_time{});
+    EXPECT_THAT(a.session.stats(0).packets_dropped, Eq(9));
+    ASSERT_THAT(a.session.ready(3), Eq(true));
+    EXPECT_THAT(a.session.remote(3).keys_down, ElementsAreArray({0}));
+}
+
+#ifndef _WIN32
+TEST_F(LockstepTest, Udp) {
+    UdpTransport ua("127.0.0.1", 0), ub("127.0.0.1", 0);
+    ua.connect("127.0.0.1", ub.port());
+    ub.connect("127.0.0.1", ua.port());
+    Peer a(&ua, 0, 3, 4), b(&ub, 1, 3, 4);
+
+    ASSERT_THAT(run(&a, &b, 200), Eq(true));
+    expect_same_input(a, b, 200);
+    expect_same_input(b, a, 200);
+    EXPECT_THAT(a.sync, Eq(b.sync));
+}
+#endif
+
+}  // namespace
+}  // namespace antares
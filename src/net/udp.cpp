@@ -0,0 +1,110 @@
+// Copyright (C) 2018 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "net/udp.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <pn/data>
+#include <pn/string>
+
+namespace antares {
+
+static std::runtime_error socket_error(pn::string_view what) {
+    return std::runtime_error(pn::format("{0}: {1}", what, strerror(errno)).c_str());
+}
+
+static sockaddr_in resolve(pn::string_view host, int port) {
+    addrinfo hints    = {};
+    hints.ai_family   = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+
+    addrinfo*  info;
+    pn::string service = pn::format("{0}", port);
+    int        err     = getaddrinfo(host.copy().c_str(), service.c_str(), &hints, &info);
+    if (err != 0) {
+        throw std::runtime_error(pn::format("{0}: {1}", host, gai_strerror(err)).c_str());
+    }
+    sockaddr_in addr;
+    memcpy(&addr, info->ai_addr, sizeof(addr));
+    freeaddrinfo(info);
+    return addr;
+}
+
+UdpTransport::UdpTransport(pn::string_view host, int port) {
+    sockaddr_in addr = resolve(host, port);
+    _fd              = socket(AF_INET, SOCK_DGRAM, 0);
+    if (_fd < 0) {
+        throw socket_error("socket");
+    }
+    if ((bind(_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) ||
+        (fcntl(_fd, F_SETFL, fcntl(_fd, F_GETFL) | O_NONBLOCK) < 0)) {
+        std::runtime_error e = socket_error(pn::format("{0}:{1}", host, port));
+        close(_fd);
+        throw e;
+    }
+}
+
+UdpTransport::~UdpTransport() { close(_fd); }
+
+int UdpTransport::port() const {
+    sockaddr_in addr;
+    socklen_t   size = sizeof(addr);
+    if (getsockname(_fd, reinterpret_cast<sockaddr*>(&addr), &size) < 0) {
+        throw socket_error("getsockname");
+    }
+    return ntohs(addr.sin_port);
+}
+
+void UdpTransport::connect(pn::string_view host, int port) {
+    sockaddr_in addr = resolve(host, port);
+    if (::connect(_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        throw socket_error(pn::format("{0}:{1}", host, port));
+    }
+}
+
+void UdpTransport::send(pn::data_view packet) {
+    // A lost packet is nothing new to the lockstep session, so neither is one that couldn't be
+    // sent because the buffer is full or the peer isn't listening yet.
+    if ((::send(_fd, packet.data(), packet.size(), 0) < 0) && (errno != EAGAIN) &&
+        (errno != EWOULDBLOCK) && (errno != ECONNREFUSED)) {
+        throw socket_error("send");
+    }
+}
+
+bool UdpTransport::receive(pn::data* packet) {
+    while (true) {
+        packet->resize(65536);
+        ssize_t size = recv(_fd, packet->data(), packet->size(), 0);
+        if (size >= 0) {
+            packet->resize(size);
+            return true;
+        } else if (errno == ECONNREFUSED) {
+            continue;  // reported for an earlier send(); see above.
+        } else if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+            return false;
+        }
+        throw socket_error("recv");
+    }
+}
+
+}  // namespace antares
@@ -0,0 +1,263 @@
+// Copyright (C) 2018 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "sound/mixing-driver.hpp"
+
+#include <string.h>
+#include <algorithm>
+#include <pn/string>
+
+#include "data/audio.hpp"
+#include "data/resource.hpp"
+#include "game/sys.hpp"
+#include "game/time.hpp"
+
+using std::shared_ptr;
+using std::unique_ptr;
+
+namespace antares {
+
+namespace {
+
+const int     kMixRate       = 44100;  // output frames per second.
+const int     kMixChannels   = 2;
+const int     kMixBlock      = 4096;  // frames mixed at a time.
+const int32_t kFullVolume    = 255 * 8;  // a sound's volume times the global volume, at most.
+const int     kWavHeaderSize = 44;
+
+void put_le(uint8_t* out, uint32_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        out[i] = value >> (8 * i);
+    }
+}
+
+}  // namespace
+
+// What a channel is playing.  Shared between the channel and the driver, so that channels can
+// outlive the driver, as they can with the other drivers, and so that a sound keeps playing to
+// its end after its channel is closed.  The channel never refers back to the driver once it is
+// closed; it only marks its voice `closed`.
+struct MixingSoundDriver::Voice {
+    shared_ptr<const SoundData> sound;
+    int32_t                     volume  = 0;
+    bool                        loop    = false;
+    bool                        closed  = false;
+    int64_t                     elapsed = 0;  // output frames since `sound` started.
+
+    void start(shared_ptr<const SoundData> sound, uint8_t volume, bool loop) {
+        this->sound   = sound;
+        this->volume  = volume;
+        this->loop    = loop;
+        this->elapsed = 0;
+    }
+
+    // Adds `frames` frames of the sound to `out`, which is interleaved stereo.
+    void mix(int32_t* out, int64_t frames, int32_t global_volume) {
+        const int16_t* samples  = reinterpret_cast<const int16_t*>(sound->data.data());
+        const int      channels = sound->channels;
+        const int64_t  count    = sound->data.size() / (sizeof(int16_t) * channels);
+        const int32_t  gain     = volume * global_volume;
+        for (int64_t i = 0; i < frames; ++i) {
+            int64_t src = (elapsed++ * sound->frequency) / kMixRate;
+            if (src >= count) {
+                if (!loop || (count == 0)) {
+                    sound.reset();
+                    return;
+                }
+                elapsed = 1;
+                src     = 0;
+            }
+            const int16_t* frame = samples + (src * channels);
+            const int32_t  left  = frame[0];
+            const int32_t  right = (channels > 1) ? frame[1] : left;
+            out[(2 * i) + 0] += (left * gain) / kFullVolume;
+            out[(2 * i) + 1] += (right * gain) / kFullVolume;
+        }
+    }
+
+    // The number of output frames left before the sound ends.  Zero if it is looping.
+    int64_t remaining() const {
+        if (!sound || loop || (sound->frequency == 0)) {
+            return 0;
+        }
+        const int64_t count = sound->data.size() / (sizeof(int16_t) * sound->channels);
+        return std::max<int64_t>(0, ((count * kMixRate) / sound->frequency) - elapsed);
+    }
+};
+
+class MixingSoundDriver::MixingChannel : public SoundChannel {
+  public:
+    MixingChannel(MixingSoundDriver& driver, shared_ptr<Voice> voice)
+            : _driver(driver), _voice(voice) {}
+    ~MixingChannel() {
+        _voice->loop   = false;
+        _voice->closed = true;
+    }
+
+    void activate() override { _driver._active_voice = _voice; }
+
+    void quiet() override {
+        _driver.advance();
+        _voice->sound.reset();
+    }
+
+  private:
+    MixingSoundDriver& _driver;
+    shared_ptr<Voice>  _voice;
+};
+
+class MixingSoundDriver::MixingSound : public Sound {
+  public:
+    MixingSound(MixingSoundDriver& driver, SoundData data)
+            : _driver(driver), _data(new SoundData(std::move(data))) {}
+
+    virtual void play(uint8_t volume) { start(volume, false); }
+    virtual void loop(uint8_t volume) { start(volume, true); }
+
+  private:
+    void start(uint8_t volume, bool loop) {
+        const shared_ptr<Voice>& voice = _driver._active_voice;
+        if (voice && !voice->closed) {
+            _driver.advance();
+            voice->start(_data, volume, loop);
+        }
+    }
+
+    MixingSoundDriver&                _driver;
+    const shared_ptr<const SoundData> _data;
+};
+
+MixingSoundDriver::MixingSoundDriver(pn::string_view path)
+        : _file(fopen(path.copy().c_str(), "wb"), fclose),
+          _frames(0),
+          _global_volume(8) {
+    if (!_file) {
+        throw std::runtime_error(pn::format("{0}: couldn't open for writing", path).c_str());
+    }
+    write_header();
+}
+
+MixingSoundDriver::~MixingSoundDriver() {
+    catch_up();
+
+    // Let sounds that are still playing finish, rather than cutting them off at the last event.
+    // Loops would never finish, so they stop.
+    int64_t tail = 0;
+    for (const auto& voice : _voices) {
+        tail = std::max(tail, voice->remaining());
+        if (voice->loop) {
+            voice->sound.reset();
+        }
+    }
+    mix(tail);
+    write_header();
+}
+
+unique_ptr<SoundChannel> MixingSoundDriver::open_channel() {
+    shared_ptr<Voice> voice(new Voice);
+    _voices.push_back(voice);
+    return unique_ptr<SoundChannel>(new MixingChannel(*this, voice));
+}
+
+unique_ptr<Sound> MixingSoundDriver::open_sound(pn::string_view path) {
+    return open_sound(Resource::sound(path));
+}
+
+unique_ptr<Sound> MixingSoundDriver::open_music(pn::string_view path) {
+    return open_sound(Resource::music(path));
+}
+
+unique_ptr<Sound> MixingSoundDriver::open_sound(SoundData data) {
+    return unique_ptr<Sound>(new MixingSound(*this, std::move(data)));
+}
+
+void MixingSoundDriver::set_global_volume(uint8_t volume) {
+    advance();
+    _global_volume = volume;
+}
+
+// Mixes everything up to the current time, so that a change that happens now takes effect here.
+void MixingSoundDriver::advance() {
+    catch_up();
+    if (ferror(_file.get())) {
+        throw std::runtime_error("couldn't write mixed audio");
+    }
+}
+
+// As advance(), but without checking for write errors, so that the destructor can call it.
+void MixingSoundDriver::catch_up() {
+    if (!sys.video) {
+        return;  // no clock to follow, before or after the game runs.
+    }
+    int64_t target = (now().time_since_epoch().count() * kMixRate) / 1000000;
+    if (target > _frames) {
+        mix(target - _frames);
+    }
+}
+
+void MixingSoundDriver::mix(int64_t frames) {
+    // Forget voices that have finished, and whose channels are closed.
+    _voices.erase(
+            std::remove_if(
+                    _voices.begin(), _voices.end(),
+                    [](const shared_ptr<Voice>& v) { return !v->sound && v->closed; }),
+            _voices.end());
+
+    int32_t buffer[kMixBlock * kMixChannels];
+    uint8_t out[kMixBlock * kMixChannels * sizeof(int16_t)];
+    while (frames > 0) {
+        const int64_t n = std::min<int64_t>(frames, kMixBlock);
+        memset(buffer, 0, sizeof(buffer));
+        for (const auto& voice : _voices) {
+            if (voice->sound) {
+                voice->mix(buffer, n, _global_volume);
+            }
+        }
+        for (int64_t i = 0; i < (n * kMixChannels); ++i) {
+            int32_t sample = std::max<int32_t>(-32768, std::min<int32_t>(32767, buffer[i]));
+            put_le(out + (i * 2), static_cast<uint16_t>(sample), 2);
+        }
+        fwrite(out, sizeof(int16_t) * kMixChannels, n, _file.get());
+        _frames += n;
+        frames -= n;
+    }
+}
+
+// Writes the RIFF header for the frames written so far, and returns to the end of the file.
+void MixingSoundDriver::write_header() {
+    const uint32_t data_size = _frames * kMixChannels * sizeof(int16_t);
+    uint8_t        header[kWavHeaderSize];
+    memcpy(header + 0, "RIFF", 4);
+    put_le(header + 4, data_size + kWavHeaderSize - 8, 4);
+    memcpy(header + 8, "WAVE", 4);
+    memcpy(header + 12, "fmt ", 4);
+    put_le(header + 16, 16, 4);  // size of format chunk.
+    put_le(header + 20, 1, 2);   // PCM.
+    put_le(header + 22, kMixChannels, 2);
+    put_le(header + 24, kMixRate, 4);
+    put_le(header + 28, kMixRate * kMixChannels * sizeof(int16_t), 4);
+    put_le(header + 32, kMixChannels * sizeof(int16_t), 2);
+    put_le(header + 34, 16, 2);  // bits per sample.
+    memcpy(header + 36, "data", 4);
+    put_le(header + 40, data_size, 4);
+
+    fseek(_file.get(), 0, SEEK_SET);
+    fwrite(header, 1, kWavHeaderSize, _file.get());
+    fseek(_file.get(), 0, SEEK_END);
+}
+
+}  // namespace antares
@@ -0,0 +1,185 @@
+// Copyright (C) 2018 The Antares Authors
+//
+// This file is part of Antares, a tactical space combat game.
+//
+// Antares is free software: you can redistribute it and/or modify it
+// under the terms of the Lesser GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Antares is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with Antares.  If not, see http://www.gnu.org/licenses/
+
+#include "sound/mixing-driver.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gmock/gmock.h>
+#include <pn/output>
+#include <sfz/sfz.hpp>
+#include <vector>
+
+#include "data/audio.hpp"
+
+using testing::ElementsAreArray;
+using testing::Eq;
+
+namespace antares {
+namespace {
+
+SoundData sound(int channels, int frequency, const std::vector<int16_t>& samples) {
+    SoundData data;
+    data.channels  = channels;
+    data.frequency = frequency;
+    data.data.output().write(pn::data_view{
+            reinterpret_cast<const uint8_t*>(samples.data()),
+            static_cast<int>(samples.size() * sizeof(int16_t))});
+    return data;
+}
+
+class MixingDriverTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        char dir[] = "/tmp/antares-mixing-test.XXXXXX";
+        ASSERT_THAT(mkdtemp(dir), testing::NotNull());
+        _dir  = dir;
+        _path = pn::format("{0}/sound.wav", _dir);
+    }
+
+    void TearDown() override { sfz::rmtree(_dir); }
+
+    // The samples written to the WAV file, after checking that its header describes them.
+    std::vector<int16_t> samples() {
+        std::unique_ptr<FILE, decltype(&fclose)> file(fopen(_path.c_str(), "rb"), fclose);
+        std::vector<uint8_t>                     bytes;
+        uint8_t                                  buf[1024];
+        size_t                                   n;
+        while (file && ((n = fread(buf, 1, sizeof(buf), file.get())) > 0)) {
+            bytes.insert(bytes.end(), buf, buf + n);
+        }
+
+        EXPECT_THAT(bytes.size(), testing::Ge(44));
+        EXPECT_THAT(memcmp(bytes.data(), "RIFF", 4), Eq(0));
+        EXPECT_THAT(memcmp(bytes.data() + 36, "data", 4), Eq(0));
+        uint32_t size = bytes[40] | (bytes[41] << 8) | (bytes[42] << 16) | (bytes[43] << 24);
+        EXPECT_THAT(size, Eq(bytes.size() - 44));
+
+        std::vector<int16_t> result;
+        for (size_t i = 44; (i + 1) < bytes.size(); i += 2) {
+            result.push_back(static_cast<int16_t>(bytes[i] | (bytes[i + 1] << 8)));
+        }
+        return result;
+    }
+
+    pn::string _dir;
+    pn::string _path;
+};
+
+// Two sounds on two channels, at full volume, are added together.  The output is as long as the
+// longer one, and mono sounds play on both sides.
+TEST_F(MixingDriverTest, Mix) {
+    {
+        MixingSoundDriver driver(_path);
+        auto              a  = driver.open_channel();
+        auto              b  = driver.open_channel();
+        auto              s1 = driver.open_sound(sound(1, 44100, {1000, 1000, 1000, 1000}));
+        auto              s2 = driver.open_sound(sound(2, 44100, {500, -500, 500, -500}));
+        a->activate();
+        s1->play(255);
+        b->activate();
+        s2->play(255);
+    }
+    EXPECT_THAT(samples(), ElementsAreArray({1500, 500, 1500, 500, 1000, 1000, 1000, 1000}));
+}
+
+// A sound at a lower rate is stretched to the output rate.
+TEST_F(MixingDriverTest, Resample) {
+    {
+        MixingSoundDriver driver(_path);
+        auto              channel = driver.open_channel();
+        auto              s       = driver.open_sound(sound(1, 22050, {100, 200, 300}));
+        channel->activate();
+        s->play(255);
+    }
+    EXPECT_THAT(
+            samples(),
+            ElementsAreArray({100, 100, 100, 100, 200, 200, 200, 200, 300, 300, 300, 300}));
+}
+
+// Volume scales the samples, and a sum out of range is clipped rather than wrapped.
+TEST_F(MixingDriverTest, VolumeAndClipping) {
+    {
+        MixingSoundDriver driver(_path);
+        auto              a  = driver.open_channel();
+        auto              b  = driver.open_channel();
+        auto              s1 = driver.open_sound(sound(2, 44100, {30000, -30000, 2040, -2040}));
+        auto              s2 = driver.open_sound(sound(2, 44100, {30000, -30000, 0, 0}));
+        a->activate();
+        s1->play(128);
+        b->activate();
+        s2->play(255);
+    }
+    EXPECT_THAT(samples(), ElementsAreArray({32767, -32768, 1024, -1024}));
+}
+
+// Loops still playing when the driver is destroyed are stopped, instead of running forever.
+TEST_F(MixingDriverTest, Loop) {
+    std::unique_ptr<SoundChannel> channel;
+    {
+        MixingSoundDriver driver(_path);
+        auto              s = driver.open_sound(sound(1, 44100, {1, 2, 3}));
+        channel             = driver.open_channel();
+        channel->activate();
+        s->loop(255);
+    }
+    EXPECT_THAT(samples().size(), Eq(0));
+}
+
+// Closing a channel lets its loop finish the pass it is on.
+TEST_F(MixingDriverTest, LoopClosed) {
+    {
+        MixingSoundDriver driver(_path);
+        auto              channel = driver.open_channel();
+        auto              s       = driver.open_sound(sound(1, 44100, {1, 2, 3}));
+        channel->activate();
+        s->loop(255);
+        channel.reset();
+    }
+    EXPECT_THAT(samples(), ElementsAreArray({1, 1, 2, 2, 3, 3}));
+}
+
+// Once the active channel is closed, sounds have nowhere to play until another is activated.
+TEST_F(MixingDriverTest, ActiveChannelClosed) {
+    {
+        MixingSoundDriver driver(_path);
+        auto              s       = driver.open_sound(sound(1, 44100, {1, 2, 3}));
+        auto              channel = driver.open_channel();
+        channel->activate();
+        channel.reset();
+        s->play(255);
+        channel = driver.open_channel();
+        channel->activate();
+        s->play(255);
+    }
+    EXPECT_THAT(samples(), ElementsAreArray({1, 1, 2, 2, 3, 3}));
+}
+
+// Without an active channel, there is nowhere to play a sound, so it doesn't play.
+TEST_F(MixingDriverTest, NoChannel) {
+    {
+        MixingSoundDriver driver(_path);
+        auto              s = driver.open_sound(sound(1, 44100, {1, 2, 3}));
+        s->play(255);
+        s->loop(255);
+    }
+    EXPECT_THAT(samples().size(), Eq(0));
+}
+
+}  // namespace
+}  // namespace antares
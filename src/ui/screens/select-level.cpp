@@ -32,6 +32,7 @@
 #include "game/level.hpp"
 #include "game/main.hpp"
 #include "game/sys.hpp"
+#include "lang/exception.hpp"
 #include "sound/driver.hpp"
 #include "ui/card.hpp"
 #include "ui/interface-handling.hpp"
@@ -69,7 +70,7 @@ SelectLevelScreen::SelectLevelScreen(bool* cancelled, const Level** level)
                     [this] {
                         if (_index > 0) {
                             --_index;
-                            *_level = Level::get(_chapters[_index]);
+                            load_level();
                         }
                     },
                     [this] { return _index > 0; },
@@ -80,7 +81,7 @@ SelectLevelScreen::SelectLevelScreen(bool* cancelled, const Level** level)
                     [this] {
                         if (_index < _chapters.size() - 1) {
                             ++_index;
-                            *_level = Level::get(_chapters[_index]);
+                            load_level();
                         }
                     },
                     [this] { return _index < _chapters.size() - 1; },
@@ -118,7 +119,7 @@ void SelectLevelScreen::key_down(const KeyDownEvent& event) {
                 case Key::N_TIMES:
                     _state          = UNLOCKING;
                     _unlock_chapter = 0;
-                    _unlock_digits  = ndigits(plug.levels.size());
+                    _unlock_digits  = ndigits(plug.level_names.size());
                     sys.sound.cloak_on();
                     return;
                 default: break;
@@ -152,21 +153,42 @@ void SelectLevelScreen::key_down(const KeyDownEvent& event) {
 void SelectLevelScreen::overlay() const { draw_level_name(); }
 
 void SelectLevelScreen::update_chapters(size_t* select) {
+    // Check the catalog rather than calling Level::get(), which would read every unlocked level.
     sys.ledger->unlocked_chapters(&_chapters);
     _chapters.erase(
             std::remove_if(
                     _chapters.begin(), _chapters.end(),
-                    [](int i) { return Level::get(i) == nullptr; }),
+                    [](int i) { return plug.chapters.find(i) == plug.chapters.end(); }),
             _chapters.end());
 
     if (select) {
         _index =
                 std::find(_chapters.begin(), _chapters.end(), _unlock_chapter) - _chapters.begin();
-        *_level = Level::get(_chapters[_index]);
     } else {
         _index = _chapters.size() - 1;
     }
-    *_level = Level::get(_chapters[_index]);
+    load_level();
+}
+
+// Reads the level for the selected chapter.  Levels are read when they're first selected, so
+// this is where a broken one shows up.  It's reported and dropped from the list, and the
+// neighboring chapter is selected instead, unless there is no other.
+void SelectLevelScreen::load_level() {
+    while (true) {
+        try {
+            *_level = Level::get(_chapters[_index]);
+            return;
+        } catch (std::exception& e) {
+            if (_chapters.size() <= 1) {
+                throw;
+            }
+            pn::err.format("chapter {0}: {1}\n", _chapters[_index], full_exception_string(e));
+            _chapters.erase(_chapters.begin() + _index);
+            if (_index == _chapters.size()) {
+                --_index;
+            }
+        }
+    }
 }
 
 void SelectLevelScreen::draw_level_name() const {
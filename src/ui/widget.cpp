@@ -22,6 +22,7 @@
 #include "config/keys.hpp"
 #include "data/resource.hpp"
 #include "drawing/interface.hpp"
+#include "drawing/styled-text.hpp"
 #include "drawing/text.hpp"
 
 using std::unique_ptr;
@@ -413,10 +414,17 @@ TextRect::TextRect(const TextRectData& data)
           _hue{data.hue},
           _style{data.style} {}
 
+TextRect::~TextRect() = default;
+
 void TextRect::draw(Point offset, InputMode) const {
     Rect bounds = _inner_bounds;
     bounds.offset(offset.h, offset.v);
-    draw_text_in_rect(bounds, _text.has_value() ? _text->copy() : pn::string_view{}, _style, _hue);
+    if (!_styled_text) {
+        _styled_text.reset(new StyledText(interface_text(
+                _text.has_value() ? pn::string_view{*_text} : pn::string_view{}, _style, _hue,
+                bounds.width())));
+    }
+    draw_text_in_rect(bounds, *_styled_text);
 }
 
 Rect TextRect::inner_bounds() const { return _inner_bounds; }
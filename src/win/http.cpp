@@ -22,9 +22,10 @@
 #include <wininet.h>
 
 #include <exception>
+#include <functional>
 #include <memory>
 #include <stdexcept>
-#include <pn/output>
+#include <pn/data>
 #include <pn/string>
 
 #include "build/defs.hpp"
@@ -68,7 +69,7 @@ url_components parse_url(pn::string_view url) {
 
 }  // namespace
 
-void get(pn::string_view url, pn::output_view out) {
+void get(pn::string_view url, int64_t offset, const std::function<void(pn::data_view)>& write) {
     auto u = parse_url(url);
 
     std::unique_ptr<void, decltype(&InternetCloseHandle)> session{
@@ -98,10 +99,31 @@ void get(pn::string_view url, pn::output_view out) {
             InternetCloseHandle};
     if (!request) {
         throw std::runtime_error(pn::format("{}: error opening request", url).c_str());
-    } else if (!HttpSendRequestA(request.get(), nullptr, 0, nullptr, 0)) {
+    }
+
+    pn::string headers;
+    if (offset > 0) {
+        headers = pn::format("Range: bytes={0}-\r\n", offset);
+    }
+    if (!HttpSendRequestA(request.get(), headers.data(), headers.size(), nullptr, 0)) {
         throw std::runtime_error(pn::format("{}: error sending request", url).c_str());
     }
 
+    DWORD status      = 0;
+    DWORD status_size = sizeof(status);
+    if (!HttpQueryInfoA(
+                request.get(), HTTP_QUERY_STATUS_CODE | HTTP_QUERY_FLAG_NUMBER, &status,
+                &status_size, nullptr)) {
+        throw std::runtime_error(pn::format("{}: error reading status", url).c_str());
+    } else if (status == 416) {
+        return;  // `offset` is at or past the end; there is nothing left to get.
+    } else if (status == 206) {
+        offset = 0;  // server honored the Range header.
+    } else if (status != 200) {
+        throw std::runtime_error(
+                pn::format("{}: HTTP error {}", url, static_cast<int>(status)).c_str());
+    }
+
     uint8_t buf[1024];
     while (true) {
         DWORD bytes_read;
@@ -110,7 +132,13 @@ void get(pn::string_view url, pn::output_view out) {
         } else if (bytes_read == 0) {
             break;
         }
-        out.write(pn::data_view(buf, bytes_read));
+        pn::data_view data(buf, bytes_read);
+        if (offset >= data.size()) {
+            offset -= data.size();
+            continue;
+        }
+        write(data.slice(offset, data.size() - offset));
+        offset = 0;
     }
 }
 